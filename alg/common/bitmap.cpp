@@ -0,0 +1,26 @@
+#include "bitmap.h"
+
+namespace alg {
+
+std::size_t Bitmap::Count() const {
+    std::size_t c = 0;
+    for (std::uint64_t w : words) {
+        c += __builtin_popcountll(w);
+    }
+    return c;
+}
+
+void AtomicBitmap::Resize(std::size_t bits) {
+    N = bits;
+    W = BitmapWords(bits);
+    words.reset(new std::atomic<std::uint64_t>[W]);
+    Reset();
+}
+
+void AtomicBitmap::Reset() {
+    for (std::size_t i = 0; i < W; i++) {
+        words[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace alg
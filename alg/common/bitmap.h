@@ -0,0 +1,91 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace alg {
+
+inline std::size_t BitmapWords(std::size_t bits) {
+    return (bits + 63) / 64;
+}
+
+/**
+ * @brief Fixed size bit set packed into 64-bit words
+ */
+class Bitmap {
+public:
+    Bitmap() = default;
+    explicit Bitmap(std::size_t bits)
+        : N(bits), words(BitmapWords(bits), 0) {}
+
+    void Resize(std::size_t bits) {
+        N = bits;
+        words.assign(BitmapWords(bits), 0);
+    }
+    void Reset() {
+        std::fill(words.begin(), words.end(), 0);
+    }
+
+    bool Test(std::size_t i) const {
+        return (words[i >> 6] >> (i & 63)) & 1u;
+    }
+    void Set(std::size_t i) {
+        words[i >> 6] |= std::uint64_t(1) << (i & 63);
+    }
+    void Clear(std::size_t i) {
+        words[i >> 6] &= ~(std::uint64_t(1) << (i & 63));
+    }
+
+    std::size_t Size() const {
+        return N;
+    }
+    std::size_t Count() const;
+
+public:
+    std::size_t N = 0;
+    std::vector<std::uint64_t> words;
+};
+
+/**
+ * @brief Bit set whose bits can be claimed concurrently
+ */
+class AtomicBitmap {
+public:
+    AtomicBitmap() = default;
+    explicit AtomicBitmap(std::size_t bits) {
+        Resize(bits);
+    }
+
+    void Resize(std::size_t bits);
+    void Reset();
+
+    bool Test(std::size_t i) const {
+        return (words[i >> 6].load(std::memory_order_relaxed) >> (i & 63)) & 1u;
+    }
+    void Set(std::size_t i) {
+        words[i >> 6].fetch_or(std::uint64_t(1) << (i & 63), std::memory_order_relaxed);
+    }
+    /**
+     * @brief Set bit i, true if this call changed it
+     */
+    bool TestAndSet(std::size_t i) {
+        const std::uint64_t mask = std::uint64_t(1) << (i & 63);
+        if (words[i >> 6].load(std::memory_order_relaxed) & mask)
+            return false;
+        return !(words[i >> 6].fetch_or(mask, std::memory_order_relaxed) & mask);
+    }
+
+    std::size_t Size() const {
+        return N;
+    }
+
+private:
+    std::size_t N = 0;
+    std::size_t W = 0;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> words;
+};
+
+} // namespace alg
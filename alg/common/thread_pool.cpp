@@ -0,0 +1,88 @@
+#include <algorithm>
+
+#include "thread_pool.h"
+
+namespace alg {
+
+ThreadPool::ThreadPool(int threads) {
+    for (int i = 1; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::Work, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lk(mu);
+        stop = true;
+    }
+    cv.notify_all();
+    for (auto& t : workers) {
+        t.join();
+    }
+}
+
+int ThreadPool::DefaultThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void ThreadPool::ParallelFor(std::int64_t count, std::int64_t chunk, const Body& fn) {
+    if (count <= 0)
+        return;
+    chunk = std::max<std::int64_t>(chunk, 1);
+    if (workers.empty() || count <= chunk) {
+        fn(0, count, 0);
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lk(run_mu);
+    {
+        std::lock_guard<std::mutex> lk(mu);
+        body = &fn;
+        n = count;
+        grain = chunk;
+        next.store(0, std::memory_order_relaxed);
+        pending = static_cast<int>(workers.size());
+        generation++;
+    }
+    cv.notify_all();
+
+    RunChunks(0);
+
+    std::unique_lock<std::mutex> lk(mu);
+    done_cv.wait(lk, [this] {
+        return pending == 0;
+    });
+    body = nullptr;
+}
+
+void ThreadPool::Work(int tid) {
+    std::uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lk(mu);
+            cv.wait(lk, [this, seen] {
+                return stop || generation != seen;
+            });
+            if (stop)
+                return;
+            seen = generation;
+        }
+
+        RunChunks(tid);
+
+        std::lock_guard<std::mutex> lk(mu);
+        if (--pending == 0)
+            done_cv.notify_one();
+    }
+}
+
+void ThreadPool::RunChunks(int tid) {
+    while (true) {
+        std::int64_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+        if (begin >= n)
+            return;
+        (*body)(begin, std::min(begin + grain, n), tid);
+    }
+}
+
+} // namespace alg
@@ -0,0 +1,64 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+
+namespace alg {
+
+/**
+ * @brief Fixed set of worker threads running dynamically scheduled loops
+ *
+ * The calling thread takes part in every loop as worker 0, so a pool of
+ * size 1 has no extra threads and runs everything inline. ParallelFor must
+ * not be called from inside a loop body of the same pool.
+ */
+class ThreadPool {
+public:
+    using Body = std::function<void(std::int64_t begin, std::int64_t end, int tid)>;
+
+    explicit ThreadPool(int threads = DefaultThreads());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Number of workers, including the caller
+     */
+    int Size() const {
+        return static_cast<int>(workers.size()) + 1;
+    }
+
+    /**
+     * @brief Run body over [0, n) in chunks of grain, blocks until done
+     */
+    void ParallelFor(std::int64_t n, std::int64_t grain, const Body& body);
+
+    static int DefaultThreads();
+
+private:
+    void Work(int tid);
+    void RunChunks(int tid);
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex run_mu;
+    std::mutex mu;
+    std::condition_variable cv;
+    std::condition_variable done_cv;
+    std::uint64_t generation = 0;
+    int pending = 0;
+    bool stop = false;
+
+    // current loop
+    const Body* body = nullptr;
+    std::int64_t n = 0;
+    std::int64_t grain = 1;
+    std::atomic<std::int64_t> next{0};
+};
+
+} // namespace alg
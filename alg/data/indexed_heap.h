@@ -0,0 +1,131 @@
+#pragma once
+#include <vector>
+#include <utility>
+
+namespace alg {
+
+/**
+ * @brief D-ary min heap over the ids [0, n) with decrease-key
+ *
+ * pos[id] is the slot of id in the heap or -1, so Push on a contained id
+ * lowers its key in place. Clear() costs O(size), not O(n).
+ */
+template <int D, typename K>
+class DaryHeap {
+public:
+    explicit DaryHeap(int n = 0)
+        : pos(n, -1) {}
+
+    void Resize(int n) {
+        Clear();
+        pos.assign(n, -1);
+    }
+
+    bool Empty() const {
+        return heap.empty();
+    }
+    int Size() const {
+        return heap.size();
+    }
+    bool Contains(int id) const {
+        return pos[id] != -1;
+    }
+
+    /**
+     * @brief Insert id, or lower its key if already contained
+     */
+    void Push(int id, K key) {
+        int i = pos[id];
+        if (i == -1) {
+            i = heap.size();
+            heap.push_back(Item{key, id});
+        }
+        else {
+            heap[i].key = key;
+        }
+        SwimUp(i);
+    }
+
+    const K& TopKey() const {
+        return heap[0].key;
+    }
+    int Top() const {
+        return heap[0].id;
+    }
+
+    int Pop(K& key) {
+        Item top = heap[0];
+        pos[top.id] = -1;
+        Item last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            pos[last.id] = 0;
+            SwimDown(0);
+        }
+        key = top.key;
+        return top.id;
+    }
+
+    void Clear() {
+        for (const auto& item : heap) {
+            pos[item.id] = -1;
+        }
+        heap.clear();
+    }
+
+private:
+    struct Item {
+        K key;
+        int id;
+    };
+
+    void SwimUp(int i) {
+        Item item = heap[i];
+        while (i > 0) {
+            int p = (i - 1) / D;
+            if (!(item.key < heap[p].key))
+                break;
+            heap[i] = heap[p];
+            pos[heap[i].id] = i;
+            i = p;
+        }
+        heap[i] = item;
+        pos[item.id] = i;
+    }
+
+    void SwimDown(int i) {
+        Item item = heap[i];
+        const int n = heap.size();
+        while (true) {
+            int first = i * D + 1;
+            if (first >= n)
+                break;
+            int last = first + D < n ? first + D : n;
+            int best = first;
+            for (int c = first + 1; c < last; c++) {
+                if (heap[c].key < heap[best].key)
+                    best = c;
+            }
+            if (!(heap[best].key < item.key))
+                break;
+            heap[i] = heap[best];
+            pos[heap[i].id] = i;
+            i = best;
+        }
+        heap[i] = item;
+        pos[item.id] = i;
+    }
+
+private:
+    std::vector<Item> heap;
+    std::vector<int> pos;
+};
+
+template <typename K>
+using BinaryHeap = DaryHeap<2, K>;
+
+template <typename K>
+using QuadHeap = DaryHeap<4, K>;
+
+} // namespace alg
@@ -0,0 +1,94 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace alg {
+
+/**
+ * @brief Monotone radix heap for non-negative integer keys
+ *
+ * Keys pushed must not be smaller than the last popped key, which holds for
+ * Dijkstra. Bucket b holds keys whose highest bit differing from the last
+ * popped key is bit b - 1, so every key moves down at most 64 times. Push
+ * never updates an id in place: an id pushed twice is popped twice, and
+ * the caller skips the stale copy. The id count is only kept for the same
+ * constructor as DaryHeap.
+ */
+template <typename K>
+class RadixHeap {
+    static_assert(std::is_integral<K>::value, "RadixHeap needs integer keys");
+
+public:
+    explicit RadixHeap(int n = 0) {
+        (void)n;
+    }
+
+    void Resize(int) {
+        Clear();
+    }
+
+    bool Empty() const {
+        return size == 0;
+    }
+    int Size() const {
+        return size;
+    }
+
+    void Push(int id, K key) {
+        buckets[Bucket(key)].push_back(Item{key, id});
+        size++;
+    }
+
+    int Pop(K& key) {
+        if (buckets[0].empty()) {
+            int b = 1;
+            while (buckets[b].empty()) {
+                b++;
+            }
+            // new minimum, then redistribute bucket b below it
+            K min = std::numeric_limits<K>::max();
+            for (const auto& item : buckets[b]) {
+                if (item.key < min)
+                    min = item.key;
+            }
+            last = min;
+            for (const auto& item : buckets[b]) {
+                buckets[Bucket(item.key)].push_back(item);
+            }
+            buckets[b].clear();
+        }
+        Item item = buckets[0].back();
+        buckets[0].pop_back();
+        size--;
+        key = item.key;
+        return item.id;
+    }
+
+    void Clear() {
+        for (auto& bucket : buckets) {
+            bucket.clear();
+        }
+        size = 0;
+        last = 0;
+    }
+
+private:
+    struct Item {
+        K key;
+        int id;
+    };
+
+    int Bucket(K key) const {
+        std::uint64_t diff = static_cast<std::uint64_t>(key) ^ static_cast<std::uint64_t>(last);
+        return diff == 0 ? 0 : 64 - __builtin_clzll(diff);
+    }
+
+private:
+    std::vector<Item> buckets[65];
+    K last = 0;
+    int size = 0;
+};
+
+} // namespace alg
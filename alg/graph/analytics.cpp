@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <numeric>
+
+#include "analytics.h"
+
+namespace alg {
+namespace {
+constexpr std::int64_t kGrain = 256;
+// rows this many times longer than the other are galloped through
+constexpr std::int64_t kGallop = 32;
+
+template <typename Body>
+void ForRange(ThreadPool* pool, std::int64_t n, std::int64_t grain, const Body& body) {
+    if (pool)
+        pool->ParallelFor(n, grain, body);
+    else if (n > 0)
+        body(0, n, 0);
+}
+
+// in-edges of a directed graph, rows sorted
+CsrGraph Transpose(const GraphView& g) {
+    CsrGraph t;
+    t.V = g.V;
+    t.E = g.E;
+    t.directed = true;
+    t.offsets.assign(g.V + 1, 0);
+    for (std::int64_t k = 0; k < g.offsets[g.V]; k++) {
+        t.offsets[g.neighbors[k] + 1]++;
+    }
+    std::partial_sum(t.offsets.begin(), t.offsets.end(), t.offsets.begin());
+    t.neighbors.resize(t.offsets[g.V]);
+    std::vector<std::int64_t> fill(t.offsets.begin(), t.offsets.end() - 1);
+    for (int u = 0; u < g.V; u++) {
+        for (int v : g.Adj(u)) {
+            t.neighbors[fill[v]++] = u;
+        }
+    }
+    return t;
+}
+
+// |a & b| of two sorted rows
+std::int64_t Intersect(const int* a, const int* a_end, const int* b, const int* b_end) {
+    if (a_end - a > b_end - b) {
+        std::swap(a, b);
+        std::swap(a_end, b_end);
+    }
+    std::int64_t count = 0;
+    if ((a_end - a) * kGallop < b_end - b) {
+        for (; a != a_end && b != b_end; a++) {
+            std::ptrdiff_t step = 1;
+            while (step < b_end - b && b[step] < *a) {
+                step <<= 1;
+            }
+            b = std::lower_bound(b + step / 2, b + std::min<std::ptrdiff_t>(step + 1, b_end - b), *a);
+            if (b != b_end && *b == *a) {
+                count++;
+                b++;
+            }
+        }
+        return count;
+    }
+    while (a != a_end && b != b_end) {
+        const int x = *a;
+        const int y = *b;
+        count += x == y;
+        a += x <= y;
+        b += y <= x;
+    }
+    return count;
+}
+} // namespace
+
+int PageRank(const GraphView& g, std::vector<double>& rank, ThreadPool* pool, double damping, double tolerance,
+             int max_iterations) {
+    const int V = g.V;
+    rank.assign(V, V ? 1.0 / V : 0.0);
+    if (V == 0)
+        return 0;
+    CsrGraph transposed;
+    GraphView in = g;
+    if (g.directed) {
+        transposed = Transpose(g);
+        in = transposed;
+    }
+
+    const int threads = pool ? pool->Size() : 1;
+    std::vector<double> contrib(V), next(V), dangling(threads), change(threads);
+    for (int round = 1; round <= max_iterations; round++) {
+        std::fill(dangling.begin(), dangling.end(), 0.0);
+        std::fill(change.begin(), change.end(), 0.0);
+        ForRange(pool, V, kGrain * 4, [&](std::int64_t begin, std::int64_t end, int tid) {
+            double lost = 0;
+            for (std::int64_t u = begin; u < end; u++) {
+                const int deg = g.Deg(static_cast<int>(u));
+                contrib[u] = deg ? rank[u] / deg : 0.0;
+                lost += deg ? 0.0 : rank[u];
+            }
+            dangling[tid] += lost;
+        });
+        const double base =
+            (1 - damping) / V + damping * std::accumulate(dangling.begin(), dangling.end(), 0.0) / V;
+        ForRange(pool, V, kGrain, [&](std::int64_t begin, std::int64_t end, int tid) {
+            double delta = 0;
+            for (std::int64_t v = begin; v < end; v++) {
+                double sum = 0;
+                for (int w : in.Adj(static_cast<int>(v))) {
+                    sum += contrib[w];
+                }
+                next[v] = base + damping * sum;
+                delta += std::fabs(next[v] - rank[v]);
+            }
+            change[tid] += delta;
+        });
+        rank.swap(next);
+        if (std::accumulate(change.begin(), change.end(), 0.0) < tolerance)
+            return round;
+    }
+    return max_iterations;
+}
+
+std::int64_t CountTriangles(const GraphView& g, ThreadPool* pool) {
+    const int V = g.V;
+    auto before = [&](int u, int v) {
+        const int du = g.Deg(u);
+        const int dv = g.Deg(v);
+        return du < dv || (du == dv && u < v);
+    };
+
+    // out-rows of the oriented graph keep the id order of the rows of g
+    std::vector<std::int64_t> offsets(V + 1, 0);
+    ForRange(pool, V, kGrain, [&](std::int64_t begin, std::int64_t end, int) {
+        for (std::int64_t u = begin; u < end; u++) {
+            int count = 0;
+            for (int v : g.Adj(static_cast<int>(u))) {
+                count += before(static_cast<int>(u), v);
+            }
+            offsets[u + 1] = count;
+        }
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<int> out(offsets[V]);
+    ForRange(pool, V, kGrain, [&](std::int64_t begin, std::int64_t end, int) {
+        for (std::int64_t u = begin; u < end; u++) {
+            std::int64_t k = offsets[u];
+            for (int v : g.Adj(static_cast<int>(u))) {
+                if (before(static_cast<int>(u), v))
+                    out[k++] = v;
+            }
+        }
+    });
+
+    std::atomic<std::int64_t> total{0};
+    ForRange(pool, V, 64, [&](std::int64_t begin, std::int64_t end, int) {
+        std::int64_t count = 0;
+        for (std::int64_t u = begin; u < end; u++) {
+            const int* row = out.data() + offsets[u];
+            const int* row_end = out.data() + offsets[u + 1];
+            for (const int* v = row; v != row_end; v++) {
+                count += Intersect(row, row_end, out.data() + offsets[*v], out.data() + offsets[*v + 1]);
+            }
+        }
+        total.fetch_add(count, std::memory_order_relaxed);
+    });
+    return total.load();
+}
+
+std::vector<int> CoreNumbers(const GraphView& g, ThreadPool* pool) {
+    const int V = g.V;
+    std::unique_ptr<std::atomic<int>[]> deg(new std::atomic<int>[V]);
+    std::unique_ptr<std::atomic<int>[]> core(new std::atomic<int>[V]);
+    int max_deg = 0;
+    for (int u = 0; u < V; u++) {
+        const auto row = g.Adj(u);
+        const int d = static_cast<int>(row.size() - std::count(row.begin(), row.end(), u));
+        deg[u].store(d, std::memory_order_relaxed);
+        core[u].store(-1, std::memory_order_relaxed);
+        max_deg = std::max(max_deg, d);
+    }
+    // buckets may hold stale entries, skipped unless the degree still fits
+    std::vector<std::vector<int>> buckets(max_deg + 1);
+    for (int u = 0; u < V; u++) {
+        buckets[deg[u].load(std::memory_order_relaxed)].push_back(u);
+    }
+
+    const int threads = pool ? pool->Size() : 1;
+    std::vector<std::vector<int>> found(threads), moved(threads);
+    std::vector<int> frontier;
+    int k = 0;
+    auto peel = [&](std::int64_t begin, std::int64_t end, int tid) {
+        for (std::int64_t i = begin; i < end; i++) {
+            const int u = frontier[i];
+            for (int w : g.Adj(u)) {
+                if (w == u || core[w].load(std::memory_order_relaxed) != -1)
+                    continue;
+                // degrees stop at k, so exactly one remover sees w reach it
+                int d = deg[w].load(std::memory_order_relaxed);
+                while (d > k && !deg[w].compare_exchange_weak(d, d - 1, std::memory_order_relaxed)) {
+                }
+                if (d == k + 1) {
+                    core[w].store(k, std::memory_order_relaxed);
+                    found[tid].push_back(w);
+                }
+                else if (d > k + 1) {
+                    moved[tid].push_back(w);
+                }
+            }
+        }
+    };
+    for (; k <= max_deg; k++) {
+        frontier.clear();
+        for (int u : buckets[k]) {
+            if (core[u].load(std::memory_order_relaxed) == -1 && deg[u].load(std::memory_order_relaxed) == k) {
+                core[u].store(k, std::memory_order_relaxed);
+                frontier.push_back(u);
+            }
+        }
+        std::vector<int>().swap(buckets[k]);
+
+        while (!frontier.empty()) {
+            ForRange(pool, static_cast<std::int64_t>(frontier.size()), 64, peel);
+            frontier.clear();
+            for (auto& list : found) {
+                frontier.insert(frontier.end(), list.begin(), list.end());
+                list.clear();
+            }
+        }
+        for (auto& list : moved) {
+            for (int w : list) {
+                if (core[w].load(std::memory_order_relaxed) == -1)
+                    buckets[deg[w].load(std::memory_order_relaxed)].push_back(w);
+            }
+            list.clear();
+        }
+    }
+
+    std::vector<int> result(V);
+    for (int u = 0; u < V; u++) {
+        result[u] = core[u].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+} // namespace alg
@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "alg/common/thread_pool.h"
+#include "csr.h"
+
+namespace alg {
+
+/**
+ * @brief PageRank by power iteration, pulling ranks along in-edges
+ *
+ * Every round first writes rank[u] / outdeg(u) of all vertices into one
+ * contiguous array, then each vertex sums that array over its in-neighbors,
+ * so a round has no atomics and no writes to shared cells. Vertices
+ * without out-edges spread their rank evenly over all vertices. Stops once
+ * the ranks change by less than tolerance in L1 norm or after
+ * max_iterations rounds; the ranks sum to 1.
+ *
+ * @return Number of rounds run
+ */
+int PageRank(const GraphView& g, std::vector<double>& rank, ThreadPool* pool = nullptr, double damping = 0.85,
+             double tolerance = 1e-9, int max_iterations = 100);
+
+/**
+ * @brief Number of triangles of an undirected graph, self loops ignored
+ *
+ * Edges are oriented from lower to higher (degree, id), so every vertex
+ * keeps at most sqrt(2E) out-neighbors and each triangle is found once, at
+ * its lowest vertex, by intersecting two sorted out-rows. Rows of similar
+ * length are merged without branches, a much shorter one gallops through
+ * the longer.
+ */
+std::int64_t CountTriangles(const GraphView& g, ThreadPool* pool = nullptr);
+
+/**
+ * @brief Core number of every vertex of an undirected graph
+ *
+ * The k-core is the largest subgraph whose vertices all have degree at
+ * least k; core[v] is the largest k whose k-core holds v. Peels vertices
+ * level by level from buckets of equal remaining degree. Each level's
+ * frontier is removed in parallel, and a neighbor whose degree drops to
+ * the level joins the next frontier of the same level. Self loops ignored.
+ */
+std::vector<int> CoreNumbers(const GraphView& g, ThreadPool* pool = nullptr);
+
+} // namespace alg
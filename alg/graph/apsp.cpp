@@ -0,0 +1,158 @@
+#include <new>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+
+#include "apsp.h"
+
+namespace alg {
+
+namespace {
+// c[j] = min(c[j], a + b[j]), c and b never alias
+inline void MinPlusRow(double* __restrict c, const double* __restrict b, double a, int n) {
+    for (int j = 0; j < n; j++) {
+        const double s = a + b[j];
+        c[j] = s < c[j] ? s : c[j];
+    }
+}
+
+inline void MinPlusRow(double* __restrict c, int* __restrict nc, const double* __restrict b,
+                       double a, int hop, int n) {
+    for (int j = 0; j < n; j++) {
+        const double s = a + b[j];
+        const bool less = s < c[j];
+        c[j] = less ? s : c[j];
+        nc[j] = less ? hop : nc[j];
+    }
+}
+
+void ForEach(int n, ThreadPool* pool, const std::function<void(int)>& body) {
+    if (pool == nullptr) {
+        for (int i = 0; i < n; i++) {
+            body(i);
+        }
+        return;
+    }
+    pool->ParallelFor(n, 1, [&](std::int64_t begin, std::int64_t end, int) {
+        for (std::int64_t i = begin; i < end; i++) {
+            body(static_cast<int>(i));
+        }
+    });
+}
+} // namespace
+
+APSP::APSP(int vertices, const std::vector<std::vector<double>>& graph)
+    : V(vertices),
+      N((vertices + kTile - 1) / kTile * kTile),
+      adj(graph) {
+    if (N == 0)
+        N = kTile;
+    // N * N * 8 must not wrap, and aligned_alloc reports failure by nullptr
+    if (static_cast<std::size_t>(N) > SIZE_MAX / sizeof(double) / N)
+        throw std::bad_alloc();
+    const std::size_t bytes = static_cast<std::size_t>(N) * N * sizeof(double);
+    dist.reset(static_cast<double*>(std::aligned_alloc(64, bytes)));
+    if (!dist)
+        throw std::bad_alloc();
+}
+
+void APSP::Load() {
+    double* d = dist.get();
+    const std::int64_t n = N;
+    std::fill(d, d + n * n, kInf);
+    if (paths)
+        next.assign(n * n, -1);
+    else
+        next.clear();
+
+    for (int u = 0; u < V; u++) {
+        double* row = d + u * n;
+        for (int v = 0; v < V; v++) {
+            if (IsInf( adj[u][v] ))
+                continue;
+            row[v] = adj[u][v];
+            if (paths)
+                next[u * n + v] = v;
+        }
+        if (row[u] > 0)
+            row[u] = 0;
+        if (paths)
+            next[u * n + u] = u;
+    }
+}
+
+void APSP::Tile(int ib, int jb, int kb) {
+    double* d = dist.get();
+    const std::int64_t n = N;
+    double* c = d + ib * kTile * n + jb * kTile;
+    const double* a = d + ib * kTile * n + kb * kTile;
+    const double* b = d + kb * kTile * n + jb * kTile;
+    int* nc = paths ? next.data() + ib * kTile * n + jb * kTile : nullptr;
+    const int* na = paths ? next.data() + ib * kTile * n + kb * kTile : nullptr;
+
+    // k outermost so a tile may also be its own a or b; row k of b is
+    // fixed during step k while d[k][k] >= 0, the aliased row is skipped
+    for (int k = 0; k < kTile; k++) {
+        const double* brow = b + k * n;
+        for (int i = 0; i < kTile; i++) {
+            double* crow = c + i * n;
+            const double aik = a[i * n + k];
+            if (crow == brow || IsInf(aik))
+                continue;
+            if (paths)
+                MinPlusRow(crow, nc + i * n, brow, aik, na[i * n + k], kTile);
+            else
+                MinPlusRow(crow, brow, aik, kTile);
+        }
+    }
+}
+
+void APSP::Run(bool with_paths, ThreadPool* pool) {
+    paths = with_paths;
+    Load();
+
+    const int tiles = N / kTile;
+    const int others = tiles - 1;
+    for (int kb = 0; kb < tiles; kb++) {
+        Tile(kb, kb, kb);
+        ForEach(2 * others, pool, [&](int t) {
+            int other = t % others;
+            other += other >= kb;
+            if (t < others)
+                Tile(kb, other, kb);
+            else
+                Tile(other, kb, kb);
+        });
+        ForEach(others * others, pool, [&](int t) {
+            int ib = t / others, jb = t % others;
+            ib += ib >= kb;
+            jb += jb >= kb;
+            Tile(ib, jb, kb);
+        });
+    }
+}
+
+bool APSP::NegativeCycle() const {
+    for (int u = 0; u < V; u++) {
+        if (Dist(u, u) < 0)
+            return true;
+    }
+    return false;
+}
+
+bool APSP::Path(int u, int v, std::vector<int>& path) const {
+    path.clear();
+    if (!paths || !Reachable(u, v))
+        return false;
+    path.push_back(u);
+    while (u != v) {
+        u = next[static_cast<std::int64_t>(u) * N + v];
+        path.push_back(u);
+        // only a negative cycle can make the walk this long
+        if (static_cast<int>(path.size()) > V)
+            return false;
+    }
+    return true;
+}
+
+} // namespace alg
@@ -0,0 +1,80 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include <cstdint>
+
+#include "alg/common/thread_pool.h"
+#include "graph.h"
+
+namespace alg {
+
+/**
+ * @brief All pairs shortest paths by blocked Floyd-Warshall
+ *
+ * The adjacency matrix is copied into one 64-byte aligned row-major buffer
+ * padded to a multiple of kTile. Round kb relaxes through the vertices of
+ * tile kb in three phases: the diagonal tile, then the tiles of row and
+ * column kb, then every other tile. Tiles of one phase are independent, so
+ * phases 2 and 3 run on the pool. The min-plus inner loop runs over
+ * contiguous row segments and vectorizes. Missing edges are kInf. The
+ * constructor throws std::bad_alloc, like a std container, if the matrix
+ * cannot be allocated. The graph must outlive the engine.
+ */
+class APSP {
+public:
+    static constexpr int kTile = 64;
+
+    explicit APSP(const WeightedGraph& g)
+        : APSP(g.V, g.adj) {}
+    explicit APSP(const DirectedWeightedGraph& g)
+        : APSP(g.V, g.adj) {}
+
+    /**
+     * @brief Solve, keeping next hops only if paths is set
+     */
+    void Run(bool paths = false, ThreadPool* pool = nullptr);
+
+    double Dist(int u, int v) const {
+        return dist.get()[static_cast<std::int64_t>(u) * N + v];
+    }
+    bool Reachable(int u, int v) const {
+        return !IsInf(Dist(u, v));
+    }
+
+    /**
+     * @brief true if some vertex lies on a negative cycle
+     */
+    bool NegativeCycle() const;
+
+    /**
+     * @brief Shortest path from u to v, needs Run(true)
+     */
+    bool Path(int u, int v, std::vector<int>& path) const;
+
+public:
+    int V;
+    // padded row length
+    int N;
+
+private:
+    struct Free {
+        void operator()(double* p) const {
+            std::free(p);
+        }
+    };
+
+    APSP(int vertices, const std::vector<std::vector<double>>& adj);
+
+    void Load();
+    void Tile(int ib, int jb, int kb);
+
+private:
+    const std::vector<std::vector<double>>& adj;
+    std::unique_ptr<double[], Free> dist;
+    // next hop on the shortest path, -1 if unreachable
+    std::vector<int> next;
+    bool paths = false;
+};
+
+} // namespace alg
@@ -0,0 +1,87 @@
+#include <algorithm>
+
+#include "bcc.h"
+
+namespace alg {
+
+void BCC::Run(DFS& dfs) {
+    bridges.clear();
+    separations.clear();
+    block_offsets.assign(1, 0);
+    block_edges.clear();
+    frames.clear();
+    frames.reserve(g.V);
+    edges.clear();
+
+    std::vector<bool> separation(g.V, false);
+    int pre = 0;
+    for (int root = 0; root < g.V; root++) {
+        if (dfs.pre[root] != -1)
+            continue;
+
+        int children = 0;
+        dfs.st[root] = root;
+        dfs.pre[root] = dfs.low[root] = pre++;
+        frames.push_back(Frame(root, root, g.offsets[root]));
+        while (!frames.empty()) {
+            Frame& f = frames.back();
+            if (f.next == g.offsets[f.v + 1]) {
+                int c = f.v;
+                frames.pop_back();
+                if (frames.empty())
+                    break;
+
+                // back in the parent after the tree edge (p, c)
+                int p = frames.back().v;
+                if (dfs.low[c] < dfs.low[p])
+                    dfs.low[p] = dfs.low[c];
+                if (dfs.low[c] > dfs.pre[p])
+                    bridges.push_back(Edge(p, c));
+                if (dfs.low[c] >= dfs.pre[p]) {
+                    if (p == root)
+                        children++;
+                    else
+                        separation[p] = true;
+                    PopBlock(p, c);
+                }
+                continue;
+            }
+
+            int v = f.v;
+            int w = g.neighbors[f.next++];
+            if (w == v)
+                continue;
+            if (dfs.pre[w] == -1) {
+                dfs.st[w] = v;
+                dfs.pre[w] = dfs.low[w] = pre++;
+                edges.push_back(Edge(v, w));
+                frames.push_back(Frame(v, w, g.offsets[w]));
+            }
+            else if (w != f.u && dfs.pre[w] < dfs.pre[v]) {
+                if (dfs.pre[w] < dfs.low[v])
+                    dfs.low[v] = dfs.pre[w];
+                edges.push_back(Edge(v, w));
+            }
+        }
+        if (children > 1)
+            separation[root] = true;
+    }
+
+    for (int u = 0; u < g.V; u++) {
+        if (separation[u])
+            separations.push_back(u);
+    }
+}
+
+void BCC::PopBlock(int p, int c) {
+    while (true) {
+        Edge e = edges.back();
+        edges.pop_back();
+        block_edges.push_back(e);
+        if (e.u == p && e.v == c)
+            break;
+    }
+    block_offsets.push_back(block_edges.size());
+}
+
+} // namespace alg
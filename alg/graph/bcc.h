@@ -0,0 +1,64 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "csr.h"
+#include "search.h"
+
+namespace alg {
+
+/**
+ * @brief Bridges, separation vertices and biconnected components
+ *
+ * One iterative Tarjan low-link pass over every connected component. Tree
+ * and back edges are kept on an edge stack, and a block is popped whenever
+ * a child cannot reach above its parent (low[c] >= pre[p]). The graph must
+ * outlive the engine.
+ */
+class BCC {
+public:
+    explicit BCC(const GraphView& graph)
+        : g(graph) {}
+
+    /**
+     * @brief Fill dfs.st, dfs.pre and dfs.low and collect the results
+     */
+    void Run(DFS& dfs);
+
+    int Blocks() const {
+        return static_cast<int>(block_offsets.size()) - 1;
+    }
+
+    /**
+     * @brief Edges of block b
+     */
+    Span<Edge> Block(int b) const {
+        return Span<Edge>(block_edges.data() + block_offsets[b], block_edges.data() + block_offsets[b + 1]);
+    }
+
+public:
+    std::vector<Edge> bridges;
+    // ascending
+    std::vector<int> separations;
+    // block b is block_edges[block_offsets[b], block_offsets[b + 1])
+    std::vector<std::int64_t> block_offsets;
+    std::vector<Edge> block_edges;
+
+private:
+    struct Frame {
+        Frame(int u_, int v_, std::int64_t next_)
+            : u(u_), v(v_), next(next_) {}
+
+        int u, v;
+        std::int64_t next;
+    };
+
+    void PopBlock(int p, int c);
+
+private:
+    GraphView g;
+    std::vector<Frame> frames;
+    std::vector<Edge> edges;
+};
+
+} // namespace alg
@@ -0,0 +1,383 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "alg/common/thread_pool.h"
+#include "analytics.h"
+#include "apsp.h"
+#include "components.h"
+#include "dynamic_graph.h"
+#include "euler.h"
+#include "generator.h"
+#include "mst.h"
+#include "path.h"
+#include "scc.h"
+#include "search.h"
+#include "shortest_path.h"
+#include "topo_sort.h"
+#include "weighted_csr.h"
+
+using namespace alg;
+
+namespace {
+// Floyd-Warshall is cubic, larger graphs skip the apsp phase
+constexpr int kApspMaxVertices = 1 << 11;
+
+struct Options {
+    std::string graph = "all";
+    int scale = 16;
+    std::uint64_t seed = 1;
+    int threads = ThreadPool::DefaultThreads();
+    int max_weight = 255;
+};
+
+bool ParseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* eq = std::strchr(arg, '=');
+        if (!eq)
+            return false;
+        const std::string key(arg, eq - arg);
+        const char* value = eq + 1;
+        if (key == "--graph")
+            options.graph = value;
+        else if (key == "--scale")
+            options.scale = std::atoi(value);
+        else if (key == "--seed")
+            options.seed = std::strtoull(value, nullptr, 10);
+        else if (key == "--threads")
+            options.threads = std::atoi(value);
+        else if (key == "--max_weight")
+            options.max_weight = std::atoi(value);
+        else
+            return false;
+    }
+    const bool known = options.graph == "all" || options.graph == "rmat" || options.graph == "grid" ||
+                       options.graph == "gnp";
+    return known && options.scale > 0 && options.scale < 31 && options.threads > 0 && options.max_weight > 0;
+}
+
+// directed copy of an undirected graph keeping the edges u -> v with u < v
+CsrGraph Orient(const CsrGraph& g) {
+    CsrGraph dag;
+    dag.V = g.V;
+    dag.directed = true;
+    dag.offsets.assign(g.V + 1, 0);
+    for (int u = 0; u < g.V; u++) {
+        for (int v : g.Adj(u)) {
+            if (u < v)
+                dag.neighbors.push_back(v);
+        }
+        dag.offsets[u + 1] = dag.neighbors.size();
+    }
+    dag.E = dag.neighbors.size();
+    return dag;
+}
+
+long PeakRssKb() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/**
+ * @brief Times phases of one graph, one JSON object per line
+ */
+class Reporter {
+public:
+    explicit Reporter(const std::string& graph_name)
+        : graph(graph_name) {}
+
+    template <typename F>
+    void Time(const char* phase, F&& f) {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "{\"graph\":\"" << graph << "\",\"V\":" << V << ",\"E\":" << E << ",\"phase\":\"" << phase
+                  << "\",\"seconds\":" << seconds << ",\"edges_per_second\":" << (seconds > 0 ? E / seconds : 0)
+                  << ",\"peak_rss_kb\":" << PeakRssKb() << "}" << std::endl;
+    }
+
+public:
+    int V = 0;
+    std::int64_t E = 0;
+
+private:
+    std::string graph;
+};
+
+void RunKernels(Reporter& report, int V, std::vector<Edge>& edges, const Options& options, ThreadPool& pool) {
+    report.Time("weights", [&] {
+        RandomWeights(edges, options.max_weight, options.seed);
+    });
+
+    CsrGraph g;
+    report.Time("csr", [&] {
+        g = CsrGraph(V, edges);
+    });
+    report.E = g.E;
+    WeightedCsrGraph<int> wg;
+    report.Time("weighted_csr", [&] {
+        wg = WeightedCsrGraph<int>(V, edges);
+    });
+    {
+        DynamicGraph dynamic(V);
+        report.Time("dynamic_insert", [&] {
+            dynamic.Insert(edges, &pool);
+        });
+        const auto snapshot = dynamic.Read();
+        CsrGraph copy;
+        report.Time("dynamic_topology", [&] {
+            copy = snapshot->Topology();
+        });
+    }
+    // the generated edges read as arcs, for the directed kernels
+    CsrGraph digraph;
+    report.Time("csr_directed", [&] {
+        digraph = CsrGraph(V, edges, true);
+    });
+    edges.clear();
+    edges.shrink_to_fit();
+
+    // searches start at a vertex of largest degree, inside the big component
+    int source = 0;
+    for (int u = 0; u < V; u++) {
+        if (g.Deg(u) > g.Deg(source))
+            source = u;
+    }
+
+    BFS bfs(V);
+    report.Time("bfs", [&] {
+        bfs.Run(g, source);
+    });
+    report.Time("bfs_parallel", [&] {
+        bfs.Run(g, source, &pool);
+    });
+    // farthest reached vertex as the target of point to point queries
+    const std::vector<int> order = bfs.Order();
+    const int target = order.back();
+
+    Path path(g);
+    std::vector<int> p;
+    report.Time("path_dfs", [&] {
+        path.PathDsf(source, target, p);
+    });
+    {
+        DFS dfs(V);
+        report.Time("dfs", [&] {
+            path.Dfs(dfs);
+        });
+    }
+    {
+        DFS dfs(V);
+        report.Time("dfs_cc", [&] {
+            path.DfsCC(dfs);
+        });
+    }
+    {
+        DFS dfs(V);
+        report.Time("dfs_bipartite", [&] {
+            path.DfsBipartite(dfs);
+        });
+    }
+    {
+        DFS dfs(V);
+        std::vector<Edge> bridges;
+        report.Time("dfs_bridges", [&] {
+            path.DfsBridges(dfs, bridges);
+        });
+    }
+    {
+        DFS dfs(V);
+        std::vector<int> separations;
+        report.Time("dfs_separation_vertices", [&] {
+            path.DfsSeparationVertices(dfs, separations);
+        });
+    }
+    report.Time("components", [&] {
+        ConnectedComponents(g, &pool);
+    });
+    {
+        std::vector<double> rank;
+        report.Time("pagerank", [&] {
+            PageRank(g, rank, &pool, 0.85, 1e-6);
+        });
+    }
+    report.Time("triangles", [&] {
+        CountTriangles(g, &pool);
+    });
+    report.Time("kcore", [&] {
+        CoreNumbers(g, &pool);
+    });
+    report.Time("scc", [&] {
+        SCC scc(digraph);
+        scc.Run();
+    });
+    {
+        const CsrGraph dag = Orient(g);
+        TopoSort topo(dag);
+        report.Time("topo_sort", [&] {
+            topo.Run();
+        });
+        report.Time("topo_sort_parallel", [&] {
+            topo.Run(&pool);
+        });
+    }
+    {
+        // both arcs of every edge balance every vertex, so the circuit walks
+        // the whole component of the source
+        CsrGraph symmetric = g;
+        symmetric.directed = true;
+        symmetric.E = symmetric.neighbors.size();
+        std::vector<int> circuit;
+        report.Time("euler", [&] {
+            Euler(symmetric).Circuit(source, circuit);
+        });
+    }
+
+    {
+        Dijkstra<int> dijkstra(wg);
+        report.Time("dijkstra", [&] {
+            dijkstra.Run(source);
+        });
+        report.Time("dijkstra_target", [&] {
+            dijkstra.Run(source, target);
+        });
+    }
+    {
+        BinaryDijkstra<int> dijkstra(wg);
+        report.Time("dijkstra_binary", [&] {
+            dijkstra.Run(source);
+        });
+    }
+    {
+        RadixDijkstra<int> dijkstra(wg);
+        report.Time("dijkstra_radix", [&] {
+            dijkstra.Run(source);
+        });
+    }
+    {
+        BidirectionalDijkstra<int> dijkstra(wg);
+        report.Time("dijkstra_bidirectional", [&] {
+            dijkstra.Run(source, target);
+        });
+    }
+    {
+        DeltaStepping<int> delta(wg);
+        report.Time("delta_stepping", [&] {
+            delta.Run(source, &pool);
+        });
+    }
+    {
+        // ALT lower bounds |d(L, t) - d(L, v)| from one landmark, consistent
+        // on an undirected graph
+        Dijkstra<int> landmark(wg);
+        report.Time("astar_landmark", [&] {
+            landmark.Run(order[order.size() * 3 / 4]);
+        });
+        const std::vector<std::int64_t>& dl = landmark.dist;
+        auto bound = [&](int u, int v) {
+            if (dl[u] == Unreached<int>() || dl[v] == Unreached<int>())
+                return std::int64_t(0);
+            return dl[u] > dl[v] ? dl[u] - dl[v] : dl[v] - dl[u];
+        };
+        auto to_target = [&](int v) {
+            return bound(v, target);
+        };
+        auto from_source = [&](int v) {
+            return bound(source, v);
+        };
+        Dijkstra<int> astar(wg);
+        report.Time("astar", [&] {
+            astar.Run(source, target, to_target);
+        });
+        BidirectionalDijkstra<int> bidirectional(wg);
+        report.Time("astar_bidirectional", [&] {
+            bidirectional.Run(source, target, to_target, from_source);
+        });
+    }
+    report.Time("mst_kruskal", [&] {
+        Kruskal(wg, &pool);
+    });
+    report.Time("mst_boruvka", [&] {
+        Boruvka(wg, &pool);
+    });
+    report.Time("mst_prim", [&] {
+        Prim(wg);
+    });
+    if (V <= kApspMaxVertices) {
+        WeightedGraph dense(V);
+        for (const auto& e : wg.Edges()) {
+            dense.AddEdge(e);
+        }
+        APSP apsp(dense);
+        report.Time("apsp", [&] {
+            apsp.Run(false, &pool);
+        });
+    }
+}
+} // namespace
+
+/**
+ * @brief Times the graph kernels on seeded synthetic graphs
+ *
+ * bench [--graph=all|rmat|grid|gnp] [--scale=16] [--seed=1] [--threads=N]
+ *       [--max_weight=255]
+ *
+ * Scale s means about 2^s vertices: R-MAT with edge factor 16, a square
+ * road-like grid keeping 90% of its edges, and G(n, p) of mean degree 16.
+ * Prints one JSON object per line and phase with wall time, edges per
+ * second over the graph's edges and the peak resident set so far. The
+ * cubic apsp phase only runs up to 2^11 vertices.
+ */
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseArgs(argc, argv, options)) {
+        std::cerr << "usage: bench [--graph=all|rmat|grid|gnp] [--scale=N] [--seed=N] [--threads=N] "
+                     "[--max_weight=N]"
+                  << std::endl;
+        return 1;
+    }
+    ThreadPool pool(options.threads);
+    const bool all = options.graph == "all";
+
+    if (all || options.graph == "rmat") {
+        Reporter report("rmat");
+        const int V = 1 << options.scale;
+        std::vector<Edge> edges;
+        report.V = V;
+        report.Time("generate", [&] {
+            edges = RMatEdges(options.scale, 16, options.seed, &pool);
+            report.E = static_cast<std::int64_t>(edges.size());
+        });
+        RunKernels(report, V, edges, options, pool);
+    }
+    if (all || options.graph == "grid") {
+        Reporter report("grid");
+        const int side = 1 << ((options.scale + 1) / 2);
+        std::vector<Edge> edges;
+        report.V = side * side;
+        report.Time("generate", [&] {
+            edges = GridEdges(side, side, 0.9, options.seed);
+            report.E = static_cast<std::int64_t>(edges.size());
+        });
+        RunKernels(report, side * side, edges, options, pool);
+    }
+    if (all || options.graph == "gnp") {
+        Reporter report("gnp");
+        const int V = 1 << options.scale;
+        std::vector<Edge> edges;
+        report.V = V;
+        report.Time("generate", [&] {
+            edges = GnpEdges(V, 16.0 / V, options.seed);
+            report.E = static_cast<std::int64_t>(edges.size());
+        });
+        RunKernels(report, V, edges, options, pool);
+    }
+    return 0;
+}
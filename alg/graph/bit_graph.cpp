@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "bit_graph.h"
+
+namespace alg {
+namespace {
+// rows start on a cache line
+constexpr int kRowAlign = 8;
+
+int RowWords(int vertices) {
+    const int words = (vertices + 63) / 64;
+    return std::max(kRowAlign, (words + kRowAlign - 1) / kRowAlign * kRowAlign);
+}
+
+void OrRow(std::uint64_t* __restrict dst, const std::uint64_t* __restrict src, int words) {
+    for (int k = 0; k < words; k++) {
+        dst[k] |= src[k];
+    }
+}
+
+template <typename DenseGraph>
+void FromDense(BitGraph& b, const DenseGraph& g) {
+    for (int u = 0; u < g.V; u++) {
+        for (int v = 0; v < g.V; v++) {
+            if (g.adj[u][v] == 1)
+                b.AddEdge(u, v);
+        }
+    }
+}
+} // namespace
+
+BitGraph::BitGraph(int vertices, bool is_directed)
+    : V(vertices),
+      E(0),
+      directed(is_directed),
+      words(RowWords(vertices)) {
+    const std::size_t bytes = static_cast<std::size_t>(std::max(V, 1)) * words * sizeof(std::uint64_t);
+    bits.reset(static_cast<std::uint64_t*>(std::aligned_alloc(64, bytes)));
+    std::memset(bits.get(), 0, bytes);
+}
+
+BitGraph::BitGraph(const Graph& g)
+    : BitGraph(g.V, false) {
+    FromDense(*this, g);
+}
+
+BitGraph::BitGraph(const DirectedGraph& g)
+    : BitGraph(g.V, true) {
+    FromDense(*this, g);
+}
+
+BitGraph::BitGraph(const CsrGraph& g)
+    : BitGraph(g.V, g.directed) {
+    for (int u = 0; u < V; u++) {
+        for (int v : g.Adj(u)) {
+            AddEdge(u, v);
+        }
+    }
+}
+
+void BitGraph::AddEdge(int u, int v) {
+    if (HasEdge(u, v))
+        return;
+    MutableRow(u)[v >> 6] |= std::uint64_t(1) << (v & 63);
+    if (!directed)
+        MutableRow(v)[u >> 6] |= std::uint64_t(1) << (u & 63);
+    E++;
+}
+
+void BitGraph::RemoveEdge(int u, int v) {
+    if (!HasEdge(u, v))
+        return;
+    MutableRow(u)[v >> 6] &= ~(std::uint64_t(1) << (v & 63));
+    if (!directed)
+        MutableRow(v)[u >> 6] &= ~(std::uint64_t(1) << (u & 63));
+    E--;
+}
+
+std::vector<int> BitGraph::Adj(int u) const {
+    std::vector<int> nodes;
+    nodes.reserve(Deg(u));
+    ForEachAdj(u, [&](int v) {
+        nodes.push_back(v);
+    });
+    return nodes;
+}
+
+int BitGraph::Deg(int u) const {
+    const std::uint64_t* row = Row(u);
+    int d = 0;
+    for (int k = 0; k < words; k++) {
+        d += __builtin_popcountll(row[k]);
+    }
+    return d;
+}
+
+void BitBFS(const BitGraph& g, int source, std::vector<int>& dist) {
+    dist.assign(g.V, -1);
+    const int words = g.Words();
+    std::vector<std::uint64_t> visited(words, 0), frontier(words, 0), next(words, 0);
+    visited[source >> 6] = frontier[source >> 6] = std::uint64_t(1) << (source & 63);
+    dist[source] = 0;
+
+    for (int d = 1; ; d++) {
+        std::fill(next.begin(), next.end(), 0);
+        for (int k = 0; k < words; k++) {
+            for (std::uint64_t w = frontier[k]; w; w &= w - 1) {
+                OrRow(next.data(), g.Row(k * 64 + __builtin_ctzll(w)), words);
+            }
+        }
+        bool found = false;
+        for (int k = 0; k < words; k++) {
+            next[k] &= ~visited[k];
+            visited[k] |= next[k];
+            for (std::uint64_t w = next[k]; w; w &= w - 1) {
+                dist[k * 64 + __builtin_ctzll(w)] = d;
+                found = true;
+            }
+        }
+        if (!found)
+            break;
+        frontier.swap(next);
+    }
+}
+
+std::int64_t CountTriangles(const BitGraph& g, ThreadPool* pool) {
+    std::atomic<std::int64_t> total{0};
+    auto body = [&](std::int64_t begin, std::int64_t end, int) {
+        std::int64_t count = 0;
+        for (std::int64_t u = begin; u < end; u++) {
+            const std::uint64_t* ru = g.Row(static_cast<int>(u));
+            g.ForEachAdj(static_cast<int>(u), [&](int v) {
+                if (v <= u)
+                    return;
+                // common neighbors w > v
+                const std::uint64_t* rv = g.Row(v);
+                int k = (v + 1) >> 6;
+                if (k < g.Words()) {
+                    const std::uint64_t above = ~std::uint64_t(0) << ((v + 1) & 63);
+                    count += __builtin_popcountll(ru[k] & rv[k] & above);
+                }
+                for (k++; k < g.Words(); k++) {
+                    count += __builtin_popcountll(ru[k] & rv[k]);
+                }
+            });
+        }
+        total.fetch_add(count, std::memory_order_relaxed);
+    };
+    if (pool)
+        pool->ParallelFor(g.V, 16, body);
+    else if (g.V > 0)
+        body(0, g.V, 0);
+    return total.load();
+}
+
+bool IsClique(const BitGraph& g, const std::vector<int>& vertices) {
+    const int words = g.Words();
+    std::vector<std::uint64_t> members(words, 0);
+    for (int u : vertices) {
+        members[u >> 6] |= std::uint64_t(1) << (u & 63);
+    }
+    for (int u : vertices) {
+        const std::uint64_t* row = g.Row(u);
+        const std::uint64_t self = std::uint64_t(1) << (u & 63);
+        for (int k = 0; k < words; k++) {
+            const std::uint64_t want = k == (u >> 6) ? members[k] & ~self : members[k];
+            if ((row[k] & want) != want)
+                return false;
+        }
+    }
+    return true;
+}
+
+} // namespace alg
@@ -0,0 +1,110 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include <cstdint>
+
+#include "alg/common/thread_pool.h"
+#include "graph.h"
+#include "csr.h"
+
+namespace alg {
+
+/**
+ * @brief Adjacency matrix packed one bit per cell
+ *
+ * Row u is Words() 64-bit words starting on a 64-byte boundary, padding
+ * bits are zero. Deg is a popcount over the row and Adj walks set bits with
+ * count-trailing-zeros, so both cost V / 64 word operations, and the row
+ * loops below are plain word loops the compiler vectorizes. Meant for
+ * dense graphs of up to about 64k vertices (512 MB at that size).
+ */
+class BitGraph {
+public:
+    explicit BitGraph(int vertices, bool is_directed = false);
+    explicit BitGraph(const Graph& g);
+    explicit BitGraph(const DirectedGraph& g);
+    explicit BitGraph(const CsrGraph& g);
+
+    bool HasEdge(int u, int v) const {
+        return (Row(u)[v >> 6] >> (v & 63)) & 1u;
+    }
+
+    /**
+     * @brief Add u-v, E only changes if the edge is new
+     */
+    void AddEdge(int u, int v);
+    void RemoveEdge(int u, int v);
+
+    const std::uint64_t* Row(int u) const {
+        return bits.get() + static_cast<std::int64_t>(u) * words;
+    }
+
+    /**
+     * @brief Calls f(v) for every neighbor v of u in increasing order
+     */
+    template <typename F>
+    void ForEachAdj(int u, F&& f) const {
+        const std::uint64_t* row = Row(u);
+        for (int k = 0; k < words; k++) {
+            for (std::uint64_t w = row[k]; w; w &= w - 1) {
+                f(k * 64 + __builtin_ctzll(w));
+            }
+        }
+    }
+
+    std::vector<int> Adj(int u) const;
+
+    int Deg(int u) const;
+
+    /**
+     * @brief Row length in 64-bit words, a multiple of 8
+     */
+    int Words() const {
+        return words;
+    }
+
+public:
+    int V;
+    std::int64_t E;
+    bool directed;
+
+private:
+    struct Free {
+        void operator()(std::uint64_t* p) const {
+            std::free(p);
+        }
+    };
+
+    std::uint64_t* MutableRow(int u) {
+        return bits.get() + static_cast<std::int64_t>(u) * words;
+    }
+
+private:
+    int words;
+    std::unique_ptr<std::uint64_t[], Free> bits;
+};
+
+/**
+ * @brief Hop distances from source, -1 if unreachable
+ *
+ * Each level ORs the rows of the frontier vertices and masks out the
+ * visited set, one word at a time.
+ */
+void BitBFS(const BitGraph& g, int source, std::vector<int>& dist);
+
+/**
+ * @brief Triangles of an undirected graph, self-loops ignored
+ *
+ * Every edge u < v adds popcount(row[u] & row[v]) over the vertices w > v,
+ * so each triangle is counted once. Rows are split over the pool.
+ */
+std::int64_t CountTriangles(const BitGraph& g, ThreadPool* pool = nullptr);
+
+/**
+ * @brief true if every two distinct vertices are adjacent (both ways if
+ *        directed)
+ */
+bool IsClique(const BitGraph& g, const std::vector<int>& vertices);
+
+} // namespace alg
@@ -0,0 +1,176 @@
+#include <numeric>
+#include <iostream>
+
+#include "components.h"
+
+namespace alg {
+namespace {
+constexpr std::int64_t kGrain = 4096;
+// neighbors per vertex linked before the largest component is sampled
+constexpr int kSampleRounds = 2;
+constexpr int kSamples = 1024;
+
+void ParallelFor(ThreadPool* pool, std::int64_t n, const ThreadPool::Body& body) {
+    if (pool)
+        pool->ParallelFor(n, kGrain, body);
+    else if (n > 0)
+        body(0, n, 0);
+}
+} // namespace
+
+UnionFind::UnionFind(int n)
+    : parent(n),
+      rank(n, 0),
+      count(n) {
+    std::iota(parent.begin(), parent.end(), 0);
+}
+
+bool UnionFind::Union(int u, int v) {
+    u = Find(u);
+    v = Find(v);
+    if (u == v)
+        return false;
+    if (rank[u] < rank[v])
+        std::swap(u, v);
+    parent[v] = u;
+    if (rank[u] == rank[v])
+        rank[u]++;
+    count--;
+    return true;
+}
+
+ConcurrentUnionFind::ConcurrentUnionFind(int n)
+    : N(n),
+      parent(new std::atomic<int>[n]) {
+    for (int i = 0; i < n; i++) {
+        parent[i].store(i, std::memory_order_relaxed);
+    }
+}
+
+bool ConcurrentUnionFind::Union(int u, int v) {
+    while (true) {
+        u = Find(u);
+        v = Find(v);
+        if (u == v)
+            return false;
+        if (u < v)
+            std::swap(u, v);
+        // u may have been hooked meanwhile, then retry from the new roots
+        int expected = u;
+        if (parent[u].compare_exchange_strong(expected, v, std::memory_order_relaxed))
+            return true;
+    }
+}
+
+void Components::Build(const std::vector<int>& rep) {
+    const int V = rep.size();
+    std::vector<int> label(V, -1);
+    cc.resize(V);
+    int n = 0;
+    for (int u = 0; u < V; u++) {
+        int& l = label[rep[u]];
+        if (l == -1)
+            l = n++;
+        cc[u] = l;
+    }
+
+    offsets.assign(n + 1, 0);
+    for (int u = 0; u < V; u++) {
+        offsets[cc[u] + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    members.resize(V);
+    std::vector<int> cursor(offsets.begin(), offsets.end() - 1);
+    for (int u = 0; u < V; u++) {
+        members[cursor[cc[u]]++] = u;
+    }
+}
+
+void Components::Show() const {
+    for (int c = 0; c < Count(); c++) {
+        for (int u : Members(c)) {
+            std::cout << u << ",";
+        }
+        std::cout << std::endl;
+    }
+}
+
+Components ConnectedComponents(UnionFind& uf) {
+    std::vector<int> rep(uf.Size());
+    for (int u = 0; u < uf.Size(); u++) {
+        rep[u] = uf.Find(u);
+    }
+    Components c;
+    c.Build(rep);
+    return c;
+}
+
+Components ConnectedComponents(ConcurrentUnionFind& uf, ThreadPool* pool) {
+    std::vector<int> rep(uf.Size());
+    ParallelFor(pool, uf.Size(), [&](std::int64_t b, std::int64_t e, int) {
+        for (std::int64_t u = b; u < e; u++) {
+            rep[u] = uf.Find(u);
+        }
+    });
+    Components c;
+    c.Build(rep);
+    return c;
+}
+
+Components ConnectedComponents(int V, const std::vector<Edge>& edges, ThreadPool* pool) {
+    if (!pool || pool->Size() == 1) {
+        UnionFind uf(V);
+        for (const auto& e : edges) {
+            uf.Union(e.u, e.v);
+        }
+        return ConnectedComponents(uf);
+    }
+
+    ConcurrentUnionFind uf(V);
+    pool->ParallelFor(edges.size(), kGrain, [&](std::int64_t b, std::int64_t e, int) {
+        for (std::int64_t i = b; i < e; i++) {
+            uf.Union(edges[i].u, edges[i].v);
+        }
+    });
+    return ConnectedComponents(uf, pool);
+}
+
+Components ConnectedComponents(const GraphView& g, ThreadPool* pool) {
+    ConcurrentUnionFind uf(g.V);
+    for (int r = 0; r < kSampleRounds; r++) {
+        ParallelFor(pool, g.V, [&](std::int64_t b, std::int64_t e, int) {
+            for (int u = b; u < e; u++) {
+                if (g.Deg(u) > r)
+                    uf.Union(u, g.neighbors[g.offsets[u] + r]);
+            }
+        });
+    }
+
+    // An undirected edge is stored in both rows, so a vertex of the largest
+    // component can skip its row: the other end links it if needed.
+    int big = -1;
+    if (!g.directed && g.V > 0) {
+        std::vector<int> hits(g.V, 0);
+        int best = 0;
+        for (int i = 0; i < kSamples; i++) {
+            int r = uf.Find(static_cast<std::int64_t>(i) * g.V / kSamples);
+            if (++hits[r] > best) {
+                best = hits[r];
+                big = r;
+            }
+        }
+    }
+
+    ParallelFor(pool, g.V, [&](std::int64_t b, std::int64_t e, int) {
+        for (int u = b; u < e; u++) {
+            if (big != -1 && uf.Find(u) == big)
+                continue;
+            for (std::int64_t k = g.offsets[u] + kSampleRounds; k < g.offsets[u + 1]; k++) {
+                uf.Union(u, g.neighbors[k]);
+            }
+        }
+    });
+    return ConnectedComponents(uf, pool);
+}
+
+} // namespace alg
@@ -0,0 +1,140 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+#include "alg/common/thread_pool.h"
+#include "edge.h"
+#include "csr.h"
+
+namespace alg {
+
+/**
+ * @brief Disjoint-set forest with path halving and union by rank
+ *
+ * AddEdge keeps the components current while edges stream in.
+ */
+class UnionFind {
+public:
+    explicit UnionFind(int n);
+
+    int Find(int u) {
+        while (parent[u] != u) {
+            parent[u] = parent[parent[u]];
+            u = parent[u];
+        }
+        return u;
+    }
+
+    /**
+     * @brief Merge the sets of u and v, false if they already were one
+     */
+    bool Union(int u, int v);
+
+    bool AddEdge(int u, int v) {
+        return Union(u, v);
+    }
+    bool AddEdge(const Edge& e) {
+        return Union(e.u, e.v);
+    }
+
+    bool Connected(int u, int v) {
+        return Find(u) == Find(v);
+    }
+
+    /**
+     * @brief Number of components
+     */
+    int Count() const {
+        return count;
+    }
+
+    int Size() const {
+        return static_cast<int>(parent.size());
+    }
+
+public:
+    std::vector<int> parent;
+    std::vector<unsigned char> rank;
+    int count;
+};
+
+/**
+ * @brief Lock-free disjoint-set forest
+ *
+ * A root is only ever hooked under a smaller root with one CAS, so
+ * parent[u] <= u always holds and concurrent unions cannot form cycles.
+ */
+class ConcurrentUnionFind {
+public:
+    explicit ConcurrentUnionFind(int n);
+
+    int Find(int u) {
+        while (true) {
+            int p = parent[u].load(std::memory_order_relaxed);
+            if (p == u)
+                return u;
+            int gp = parent[p].load(std::memory_order_relaxed);
+            if (p != gp)
+                parent[u].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+            u = gp;
+        }
+    }
+
+    bool Union(int u, int v);
+
+    int Size() const {
+        return N;
+    }
+
+private:
+    int N;
+    std::unique_ptr<std::atomic<int>[]> parent;
+};
+
+/**
+ * @brief Connected components as a flat label array plus CSR member lists
+ *
+ * Ids are given in order of the smallest vertex of each component, which is
+ * the numbering Path::DfsCC produces, and members are ascending.
+ */
+class Components {
+public:
+    Components() = default;
+
+    int Count() const {
+        return static_cast<int>(offsets.size()) - 1;
+    }
+    Span<int> Members(int c) const {
+        return Span<int>(members.data() + offsets[c], members.data() + offsets[c + 1]);
+    }
+
+    /**
+     * @brief Group vertices by representative, rep[u] is any vertex of u's set
+     */
+    void Build(const std::vector<int>& rep);
+
+    void Show() const;
+
+public:
+    std::vector<int> cc;
+    std::vector<int> offsets = {0};
+    std::vector<int> members;
+};
+
+Components ConnectedComponents(UnionFind& uf);
+Components ConnectedComponents(ConcurrentUnionFind& uf, ThreadPool* pool = nullptr);
+
+/**
+ * @brief Union-find over an edge list, split across the pool
+ */
+Components ConnectedComponents(int V, const std::vector<Edge>& edges, ThreadPool* pool = nullptr);
+
+/**
+ * @brief Afforest: link a few sampled neighbors per vertex first, then
+ * finish only the vertices outside the largest component found so far
+ */
+Components ConnectedComponents(const GraphView& g, ThreadPool* pool = nullptr);
+
+} // namespace alg
@@ -0,0 +1,106 @@
+#include <cstring>
+#include <algorithm>
+#include <string_view>
+
+#include "concurrent_name_index.h"
+
+namespace alg {
+namespace {
+int HashShard(const char* name, std::size_t len, int shards) {
+    return std::hash<std::string_view>()(std::string_view(name, len)) % shards;
+}
+
+void ParallelFor(ThreadPool* pool, std::int64_t n, const ThreadPool::Body& body) {
+    if (pool)
+        pool->ParallelFor(n, 1, body);
+    else if (n > 0)
+        body(0, n, 0);
+}
+} // namespace
+
+int FrozenNameIndex::Find(const char* name) const {
+    const int s = HashShard(name, std::strlen(name), shards);
+    auto first = sorted.begin() + shard_offsets[s];
+    auto last = sorted.begin() + shard_offsets[s + 1];
+    auto it = std::lower_bound(first, last, name, [&](int id, const char* key) {
+        return std::strcmp(Name(id), key) < 0;
+    });
+    return it != last && std::strcmp(Name(*it), name) == 0 ? *it : -1;
+}
+
+ConcurrentNameIndex::ConcurrentNameIndex(int n)
+    : shards(n),
+      shard(new Shard[n]) {}
+
+int ConcurrentNameIndex::ShardOf(const char* name, std::size_t& len) const {
+    len = std::strlen(name);
+    return HashShard(name, len, shards);
+}
+
+int ConcurrentNameIndex::IndexByName(const char* name) {
+    std::size_t len;
+    Shard& s = shard[ShardOf(name, len)];
+    std::lock_guard<std::mutex> lk(s.mu);
+    const std::size_t local = s.index.IndexByName(name);
+    if (local < s.ids.size())
+        return s.ids[local];
+
+    const int id = N.fetch_add(1, std::memory_order_acq_rel);
+    s.ids.push_back(id);
+    s.chars.insert(s.chars.end(), name, name + len + 1);
+    s.offsets.push_back(s.chars.size());
+    return id;
+}
+
+int ConcurrentNameIndex::Find(const char* name) const {
+    std::size_t len;
+    const Shard& s = shard[ShardOf(name, len)];
+    std::lock_guard<std::mutex> lk(s.mu);
+    const int local = s.index.Find(name);
+    return local == -1 ? -1 : s.ids[local];
+}
+
+FrozenNameIndex ConcurrentNameIndex::Freeze(ThreadPool* pool) const {
+    FrozenNameIndex frozen;
+    frozen.shards = shards;
+    const int n = Count();
+
+    // name lengths by id, then every shard copies its names into place
+    std::vector<std::int64_t>& name_at = frozen.name_at;
+    name_at.assign(n + 1, 0);
+    ParallelFor(pool, shards, [&](std::int64_t b, std::int64_t e, int) {
+        for (std::int64_t k = b; k < e; k++) {
+            const Shard& s = shard[k];
+            for (std::size_t i = 0; i < s.ids.size(); i++) {
+                name_at[s.ids[i] + 1] = s.offsets[i + 1] - s.offsets[i];
+            }
+        }
+    });
+    for (int id = 0; id < n; id++) {
+        name_at[id + 1] += name_at[id];
+    }
+    frozen.chars.resize(name_at[n]);
+    frozen.shard_offsets.assign(shards + 1, 0);
+    for (int k = 0; k < shards; k++) {
+        frozen.shard_offsets[k + 1] = frozen.shard_offsets[k] + shard[k].ids.size();
+    }
+    frozen.sorted.resize(n);
+
+    ParallelFor(pool, shards, [&](std::int64_t b, std::int64_t e, int) {
+        for (std::int64_t k = b; k < e; k++) {
+            const Shard& s = shard[k];
+            for (std::size_t i = 0; i < s.ids.size(); i++) {
+                std::memcpy(&frozen.chars[name_at[s.ids[i]]], &s.chars[s.offsets[i]], s.offsets[i + 1] - s.offsets[i]);
+            }
+            auto first = frozen.sorted.begin() + frozen.shard_offsets[k];
+            std::copy(s.ids.begin(), s.ids.end(), first);
+            std::sort(first, first + s.ids.size(), [&](int x, int y) {
+                return std::strcmp(frozen.Name(x), frozen.Name(y)) < 0;
+            });
+        }
+    });
+    name_at.pop_back();
+    return frozen;
+}
+
+} // namespace alg
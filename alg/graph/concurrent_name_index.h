@@ -0,0 +1,97 @@
+#pragma once
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+#include "alg/common/thread_pool.h"
+#include "name_index.h"
+
+namespace alg {
+
+/**
+ * @brief Read-only name index made by ConcurrentNameIndex::Freeze
+ *
+ * All names live NUL terminated in one buffer. Each shard keeps its ids
+ * sorted by name, so Find hashes to the shard and binary searches it.
+ */
+class FrozenNameIndex {
+public:
+    /**
+     * @brief Id of name, -1 if absent
+     */
+    int Find(const char* name) const;
+
+    int Count() const {
+        return static_cast<int>(name_at.size());
+    }
+
+    const char* Name(int id) const {
+        return chars.data() + name_at[id];
+    }
+
+private:
+    friend class ConcurrentNameIndex;
+
+    int shards = 1;
+    std::vector<char> chars;
+    // name of id starts at chars[name_at[id]]
+    std::vector<std::int64_t> name_at;
+    // shard s is sorted[shard_offsets[s], shard_offsets[s + 1])
+    std::vector<std::int64_t> shard_offsets = {0, 0};
+    std::vector<int> sorted;
+};
+
+/**
+ * @brief Thread-safe name to dense id interner
+ *
+ * Names are spread over shards by hash, each a NameIndex behind its own
+ * mutex, so threads only contend when they hit the same shard. A new name
+ * takes the next id from one atomic counter while its shard is locked, so
+ * ids are dense and never change, though their order depends on thread
+ * timing.
+ */
+class ConcurrentNameIndex {
+public:
+    static constexpr int kShards = 64;
+
+    explicit ConcurrentNameIndex(int shards = kShards);
+
+    int IndexByName(const char* name);
+
+    /**
+     * @brief Id of name, -1 if absent
+     */
+    int Find(const char* name) const;
+
+    int Count() const {
+        return N.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Compact read-only copy, shards are packed and sorted in parallel
+     *
+     * Must not run concurrently with IndexByName.
+     */
+    FrozenNameIndex Freeze(ThreadPool* pool = nullptr) const;
+
+private:
+    struct alignas(64) Shard {
+        mutable std::mutex mu;
+        NameIndex index;
+        // global id and name of every local index
+        std::vector<int> ids;
+        std::vector<char> chars;
+        std::vector<std::int64_t> offsets = {0};
+    };
+
+    int ShardOf(const char* name, std::size_t& len) const;
+
+private:
+    int shards;
+    std::unique_ptr<Shard[]> shard;
+    std::atomic<int> N{0};
+};
+
+} // namespace alg
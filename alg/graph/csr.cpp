@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <iostream>
+
+#include "csr.h"
+
+namespace alg {
+namespace {
+// sort every row, drop duplicates and close the gaps
+void SortAndCompact(int V, std::vector<std::int64_t>& offsets, std::vector<int>& neighbors) {
+    std::int64_t w = 0;
+    for (int u = 0; u < V; u++) {
+        auto first = neighbors.begin() + offsets[u];
+        auto last = neighbors.begin() + offsets[u + 1];
+        std::sort(first, last);
+        last = std::unique(first, last);
+        offsets[u] = w;
+        w = std::copy(first, last, neighbors.begin() + w) - neighbors.begin();
+    }
+    offsets[V] = w;
+    neighbors.resize(w);
+    neighbors.shrink_to_fit();
+}
+
+std::int64_t CountEdges(const CsrGraph& g) {
+    if (g.directed)
+        return g.neighbors.size();
+
+    std::int64_t loops = 0;
+    for (int u = 0; u < g.V; u++) {
+        const auto nodes = g.Adj(u);
+        if (std::binary_search(nodes.begin(), nodes.end(), u))
+            loops++;
+    }
+    return (static_cast<std::int64_t>(g.neighbors.size()) - loops) / 2 + loops;
+}
+
+template <typename DenseGraph>
+void FromDense(const DenseGraph& g, std::vector<std::int64_t>& offsets, std::vector<int>& neighbors) {
+    offsets.assign(g.V + 1, 0);
+    for (int u = 0; u < g.V; u++) {
+        offsets[u + 1] = offsets[u] + std::count(g.adj[u].begin(), g.adj[u].end(), 1);
+    }
+    neighbors.resize(offsets[g.V]);
+    for (int u = 0; u < g.V; u++) {
+        std::int64_t k = offsets[u];
+        for (int i = 0; i < g.V; i++) {
+            if (g.adj[u][i] == 1)
+                neighbors[k++] = i;
+        }
+    }
+}
+} // namespace
+
+CsrGraph::CsrGraph(int vertices, const std::vector<Edge>& edges, bool is_directed)
+    : V(vertices),
+      E(0),
+      directed(is_directed),
+      offsets(vertices + 1, 0) {
+    // pass 1: degrees
+    for (const auto& e : edges) {
+        offsets[e.u + 1]++;
+        if (!directed && e.u != e.v)
+            offsets[e.v + 1]++;
+    }
+    for (int u = 0; u < V; u++) {
+        offsets[u + 1] += offsets[u];
+    }
+
+    // pass 2: scatter
+    neighbors.resize(offsets[V]);
+    std::vector<std::int64_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (const auto& e : edges) {
+        neighbors[cursor[e.u]++] = e.v;
+        if (!directed && e.u != e.v)
+            neighbors[cursor[e.v]++] = e.u;
+    }
+
+    SortAndCompact(V, offsets, neighbors);
+    E = CountEdges(*this);
+}
+
+CsrGraph::CsrGraph(const Graph& g)
+    : V(g.V),
+      E(0),
+      directed(false) {
+    FromDense(g, offsets, neighbors);
+    E = CountEdges(*this);
+}
+
+CsrGraph::CsrGraph(const DirectedGraph& g)
+    : V(g.V),
+      E(0),
+      directed(true) {
+    FromDense(g, offsets, neighbors);
+    E = CountEdges(*this);
+}
+
+std::vector<Edge> CsrGraph::Edges() const {
+    std::vector<Edge> edges;
+    edges.reserve(E);
+    for (int u = 0; u < V; u++) {
+        for (int v : Adj(u)) {
+            if (directed || u <= v)
+                edges.push_back(Edge(u, v));
+        }
+    }
+    return edges;
+}
+
+CsrGraph GraphView::Topology() const {
+    CsrGraph g;
+    g.V = V;
+    g.E = E;
+    g.directed = directed;
+    g.offsets.assign(offsets, offsets + V + 1);
+    g.neighbors.assign(neighbors, neighbors + offsets[V]);
+    return g;
+}
+
+void CsrGraph::Show() const {
+    std::cout << "CsrGraph:" << V << std::endl;
+    for (int i = 0; i < V; i++) {
+        const auto nodes = Adj(i);
+        if (!nodes.empty()) {
+            for (int j : nodes) {
+                std::cout << "(" << i << "," << j << "),";
+            }
+            std::cout << std::endl;
+        }
+    }
+}
+
+} // namespace alg
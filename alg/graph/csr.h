@@ -0,0 +1,135 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "edge.h"
+#include "graph.h"
+
+namespace alg {
+
+/**
+ * @brief Non-owning read-only range [first, last)
+ */
+template <typename T>
+class Span {
+public:
+    Span() = default;
+    Span(const T* f, const T* l)
+        : first(f), last(l) {}
+
+    const T* begin() const {
+        return first;
+    }
+    const T* end() const {
+        return last;
+    }
+    std::size_t size() const {
+        return last - first;
+    }
+    bool empty() const {
+        return first == last;
+    }
+    const T& operator[](std::size_t i) const {
+        return first[i];
+    }
+
+private:
+    const T* first = nullptr;
+    const T* last = nullptr;
+};
+
+/**
+ * @brief Immutable compressed sparse row graph
+ *
+ * Neighbors of u are neighbors[offsets[u], offsets[u + 1]), sorted ascending
+ * and without duplicates, so traversal order matches the dense Graph::Adj().
+ * An undirected edge is stored in both rows, a self loop once.
+ */
+class CsrGraph {
+public:
+    CsrGraph()
+        : V(0),
+          E(0),
+          directed(false),
+          offsets(1, 0) {
+    }
+    CsrGraph(int vertices, const std::vector<Edge>& edges, bool is_directed = false);
+    explicit CsrGraph(const Graph& g);
+    explicit CsrGraph(const DirectedGraph& g);
+
+    Span<int> Adj(int u) const {
+        const int* base = neighbors.data();
+        return Span<int>(base + offsets[u], base + offsets[u + 1]);
+    }
+
+    int Deg(int u) const {
+        return static_cast<int>(offsets[u + 1] - offsets[u]);
+    }
+
+    /**
+     * @brief Edge list, each undirected edge once with u <= v
+     */
+    std::vector<Edge> Edges() const;
+
+    void Show() const;
+
+public:
+    int V;
+    std::int64_t E;
+    bool directed;
+    std::vector<std::int64_t> offsets;
+    std::vector<int> neighbors;
+};
+
+/**
+ * @brief Non-owning read-only CSR topology
+ *
+ * Two pointers and the sizes, so it is copied by value and shared freely
+ * between threads. Members are named as in CsrGraph, so code written
+ * against one reads the other. Any CsrGraph, WeightedCsrGraph or
+ * MappedGraph can be viewed without copying; the viewed graph must
+ * outlive the view.
+ */
+class GraphView {
+public:
+    GraphView() = default;
+    GraphView(const CsrGraph& g)
+        : V(g.V),
+          E(g.E),
+          directed(g.directed),
+          offsets(g.offsets.data()),
+          neighbors(g.neighbors.data()) {}
+    GraphView(int vertices, std::int64_t edges, bool is_directed, const std::int64_t* row_offsets,
+              const int* row_neighbors)
+        : V(vertices),
+          E(edges),
+          directed(is_directed),
+          offsets(row_offsets),
+          neighbors(row_neighbors) {}
+
+    Span<int> Adj(int u) const {
+        return Span<int>(neighbors + offsets[u], neighbors + offsets[u + 1]);
+    }
+
+    int Deg(int u) const {
+        return static_cast<int>(offsets[u + 1] - offsets[u]);
+    }
+
+    /**
+     * @brief Owning copy of the topology
+     */
+    CsrGraph Topology() const;
+
+public:
+    int V = 0;
+    std::int64_t E = 0;
+    bool directed = false;
+    const std::int64_t* offsets = kEmptyOffsets;
+    const int* neighbors = nullptr;
+
+private:
+    static constexpr std::int64_t kEmptyOffsets[1] = {0};
+};
+
+} // namespace alg
@@ -0,0 +1,180 @@
+#include <climits>
+#include <algorithm>
+#include <numeric>
+
+#include "dynamic_graph.h"
+
+namespace alg {
+namespace {
+using Page = DynamicSnapshot::Page;
+
+constexpr int kPageBits = DynamicSnapshot::kPageBits;
+constexpr int kPageSize = DynamicSnapshot::kPageSize;
+constexpr std::int64_t kGrain = 4;
+
+// rebuilds a page, merging every row with its updates sorted by (u, v);
+// arcs and loops count the changes that took effect
+std::shared_ptr<const Page> Merge(const Page& old, int first_vertex, const EdgeUpdate* x, const EdgeUpdate* end,
+                                  std::int64_t& arcs, std::int64_t& loops) {
+    auto page = std::make_shared<Page>();
+    page->neighbors.reserve(old.neighbors.size() + (end - x));
+    const int* row = old.neighbors.data();
+    for (int i = 0; i < kPageSize; i++) {
+        const int u = first_vertex + i;
+        const int* a = row + old.offsets[i];
+        const int* last = row + old.offsets[i + 1];
+        while (x != end && x->u == u) {
+            // the last update of an edge wins
+            const int v = x->v;
+            bool insert = x->insert;
+            while (++x != end && x->u == u && x->v == v) {
+                insert = x->insert;
+            }
+            while (a != last && *a < v) {
+                page->neighbors.push_back(*a++);
+            }
+            const bool present = a != last && *a == v;
+            if (present)
+                a++;
+            if (insert)
+                page->neighbors.push_back(v);
+            if (insert != present)
+                (u == v ? loops : arcs) += insert ? 1 : -1;
+        }
+        page->neighbors.insert(page->neighbors.end(), a, last);
+        page->offsets[i + 1] = static_cast<std::int64_t>(page->neighbors.size());
+    }
+    return page;
+}
+} // namespace
+
+bool DynamicSnapshot::HasEdge(int u, int v) const {
+    const Span<int> row = Adj(u);
+    return std::binary_search(row.begin(), row.end(), v);
+}
+
+CsrGraph DynamicSnapshot::Topology() const {
+    CsrGraph r;
+    r.V = V;
+    r.E = E;
+    r.directed = directed;
+    r.offsets.assign(V + 1, 0);
+    for (int u = 0; u < V; u++) {
+        r.offsets[u + 1] = r.offsets[u] + Deg(u);
+    }
+    r.neighbors.reserve(r.offsets[V]);
+    for (const auto& page : pages) {
+        r.neighbors.insert(r.neighbors.end(), page->neighbors.begin(), page->neighbors.end());
+    }
+    return r;
+}
+
+DynamicGraph::DynamicGraph(int vertices, bool is_directed)
+    : directed(is_directed),
+      empty(std::make_shared<const Page>()) {
+    auto snapshot = std::make_shared<DynamicSnapshot>();
+    snapshot->V = vertices;
+    snapshot->directed = directed;
+    snapshot->pages.assign((std::int64_t(vertices) + kPageSize - 1) >> kPageBits, empty);
+    current = std::move(snapshot);
+}
+
+std::shared_ptr<const DynamicSnapshot> DynamicGraph::Read() const {
+    return std::atomic_load(&current);
+}
+
+bool DynamicGraph::Apply(const std::vector<EdgeUpdate>& batch, ThreadPool* pool) {
+    for (const auto& x : batch) {
+        if (x.u < 0 || x.v < 0 || x.u == INT_MAX || x.v == INT_MAX)
+            return false;
+    }
+    std::lock_guard<std::mutex> lock(writer);
+    const std::shared_ptr<const DynamicSnapshot> old = std::atomic_load(&current);
+    auto next = std::make_shared<DynamicSnapshot>();
+    next->V = old->V;
+    next->E = old->E;
+    next->directed = directed;
+    next->epoch = old->epoch + 1;
+    for (const auto& x : batch) {
+        if (x.insert)
+            next->V = std::max(next->V, std::max(x.u, x.v) + 1);
+    }
+    const int page_count = static_cast<int>((std::int64_t(next->V) + kPageSize - 1) >> kPageBits);
+
+    // arcs grouped by page with a stable counting sort, so each page sorts
+    // its own share and updates of the same arc keep the batch order;
+    // deletions from vertices that do not exist are dropped
+    std::vector<std::int64_t> start(page_count + 1, 0);
+    auto for_each_arc = [&](auto&& f) {
+        for (const auto& x : batch) {
+            if (x.u < next->V)
+                f(x);
+            if (!directed && x.u != x.v && x.v < next->V)
+                f(EdgeUpdate{x.v, x.u, x.insert});
+        }
+    };
+    for_each_arc([&](const EdgeUpdate& x) {
+        start[(x.u >> kPageBits) + 1]++;
+    });
+    std::partial_sum(start.begin(), start.end(), start.begin());
+    std::vector<EdgeUpdate> arcs(start[page_count]);
+    {
+        std::vector<std::int64_t> fill(start.begin(), start.end() - 1);
+        for_each_arc([&](const EdgeUpdate& x) {
+            arcs[fill[x.u >> kPageBits]++] = x;
+        });
+    }
+    std::vector<int> touched;
+    for (int p = 0; p < page_count; p++) {
+        if (start[p + 1] > start[p])
+            touched.push_back(p);
+    }
+
+    next->pages = old->pages;
+    next->pages.resize(page_count, empty);
+    std::vector<std::int64_t> arc_delta(touched.size(), 0), loop_delta(touched.size(), 0);
+    auto body = [&](std::int64_t begin, std::int64_t end, int) {
+        for (std::int64_t t = begin; t < end; t++) {
+            const int p = touched[t];
+            EdgeUpdate* first = arcs.data() + start[p];
+            EdgeUpdate* last = arcs.data() + start[p + 1];
+            std::stable_sort(first, last, [](const EdgeUpdate& a, const EdgeUpdate& b) {
+                return a.u != b.u ? a.u < b.u : a.v < b.v;
+            });
+            next->pages[p] = Merge(*next->pages[p], p << kPageBits, first, last, arc_delta[t], loop_delta[t]);
+        }
+    };
+    const std::int64_t n = static_cast<std::int64_t>(touched.size());
+    if (pool)
+        pool->ParallelFor(n, kGrain, body);
+    else if (n > 0)
+        body(0, n, 0);
+
+    // an undirected edge changed both of its arcs
+    const std::int64_t changed = std::accumulate(arc_delta.begin(), arc_delta.end(), std::int64_t(0));
+    const std::int64_t loops = std::accumulate(loop_delta.begin(), loop_delta.end(), std::int64_t(0));
+    next->E += (directed ? changed : changed / 2) + loops;
+
+    std::atomic_store(&current, std::shared_ptr<const DynamicSnapshot>(std::move(next)));
+    return true;
+}
+
+bool DynamicGraph::Insert(const std::vector<Edge>& edges, ThreadPool* pool) {
+    std::vector<EdgeUpdate> batch;
+    batch.reserve(edges.size());
+    for (const auto& e : edges) {
+        batch.push_back({e.u, e.v, true});
+    }
+    return Apply(batch, pool);
+}
+
+bool DynamicGraph::Erase(const std::vector<Edge>& edges, ThreadPool* pool) {
+    std::vector<EdgeUpdate> batch;
+    batch.reserve(edges.size());
+    for (const auto& e : edges) {
+        batch.push_back({e.u, e.v, false});
+    }
+    return Apply(batch, pool);
+}
+
+} // namespace alg
@@ -0,0 +1,123 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+#include "alg/common/thread_pool.h"
+#include "csr.h"
+#include "edge.h"
+
+namespace alg {
+
+/**
+ * @brief One edge insertion or deletion of a batch
+ */
+struct EdgeUpdate {
+    int u;
+    int v;
+    bool insert;
+};
+
+/**
+ * @brief Immutable state of a DynamicGraph after some batch
+ *
+ * Vertices are grouped in pages of kPageSize, each page a small CSR whose
+ * rows are sorted and duplicate free, laid out as in CsrGraph. Snapshots
+ * share every page a later batch did not touch, and a page is freed once
+ * the last snapshot holding it goes away.
+ */
+class DynamicSnapshot {
+public:
+    static constexpr int kPageBits = 8;
+    static constexpr int kPageSize = 1 << kPageBits;
+
+    struct Page {
+        Page()
+            : offsets(kPageSize + 1, 0) {}
+
+        std::vector<std::int64_t> offsets;
+        std::vector<int> neighbors;
+    };
+
+    Span<int> Adj(int u) const {
+        const Page& page = *pages[u >> kPageBits];
+        const int i = u & (kPageSize - 1);
+        const int* base = page.neighbors.data();
+        return Span<int>(base + page.offsets[i], base + page.offsets[i + 1]);
+    }
+
+    int Deg(int u) const {
+        const Page& page = *pages[u >> kPageBits];
+        const int i = u & (kPageSize - 1);
+        return static_cast<int>(page.offsets[i + 1] - page.offsets[i]);
+    }
+
+    bool HasEdge(int u, int v) const;
+
+    /**
+     * @brief Contiguous copy, for the engines that run on a GraphView
+     *
+     * O(V + E) time and memory on every call, about what building a CsrGraph
+     * of the same edges costs (the bench times it as dynamic_topology). Take
+     * it once per snapshot and run every query of that snapshot on the copy.
+     */
+    CsrGraph Topology() const;
+
+public:
+    int V = 0;
+    std::int64_t E = 0;
+    bool directed = false;
+    /** @brief Number of batches applied before this snapshot */
+    std::uint64_t epoch = 0;
+    std::vector<std::shared_ptr<const Page>> pages;
+};
+
+/**
+ * @brief Sparse graph that changes by batches of edge updates
+ *
+ * A batch is sorted by vertex and target, the last update of an edge wins,
+ * and only the pages holding changed rows are rebuilt (in parallel given a
+ * pool), merging each old row with its sorted updates; everything else is
+ * shared with the previous snapshot. Inserting an edge to a vertex id past
+ * V grows V, which costs one page pointer per kPageSize ids up to it in
+ * every later snapshot, so one stray large id is paid for in memory. E
+ * counts edges as in CsrGraph, so duplicates and deletions of missing
+ * edges leave it alone.
+ *
+ * One writer at a time applies batches, any number of readers call Read()
+ * and keep the returned snapshot for as long as they need it. Readers never
+ * wait for a batch to be built: it is published by swapping one pointer when
+ * done. The pointer is read and swapped with std::atomic_load/atomic_store,
+ * which libstdc++ guards with a small pool of mutexes hashed by address, so
+ * a reader can block for the length of that swap or of another Read().
+ */
+class DynamicGraph {
+public:
+    explicit DynamicGraph(int vertices = 0, bool is_directed = false);
+
+    DynamicGraph(const DynamicGraph&) = delete;
+    DynamicGraph& operator=(const DynamicGraph&) = delete;
+
+    /**
+     * @brief Latest published snapshot
+     */
+    std::shared_ptr<const DynamicSnapshot> Read() const;
+
+    /**
+     * @brief Apply a batch in order; false, changing nothing, if an id is
+     *        negative or INT_MAX, whose V would not fit an int
+     */
+    bool Apply(const std::vector<EdgeUpdate>& batch, ThreadPool* pool = nullptr);
+
+    bool Insert(const std::vector<Edge>& edges, ThreadPool* pool = nullptr);
+    bool Erase(const std::vector<Edge>& edges, ThreadPool* pool = nullptr);
+
+private:
+    const bool directed;
+    std::mutex writer;
+    std::shared_ptr<const DynamicSnapshot::Page> empty;
+    std::shared_ptr<const DynamicSnapshot> current;
+};
+
+} // namespace alg
@@ -0,0 +1,509 @@
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <climits>
+#include <charconv>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "edge_list_reader.h"
+
+namespace alg {
+namespace {
+constexpr std::int64_t kChunkBytes = 1 << 22;
+constexpr std::int64_t kGrain = 1024;
+
+// whole file mapped read-only, empty files map to nothing
+class MappedText {
+public:
+    ~MappedText() {
+        if (data)
+            munmap(const_cast<char*>(data), size);
+    }
+
+    bool Open(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        bool ok = fstat(fd, &st) == 0;
+        size = ok ? st.st_size : 0;
+        if (ok && size > 0) {
+            void* base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ok = base != MAP_FAILED;
+            data = ok ? static_cast<const char*>(base) : nullptr;
+            if (ok)
+                madvise(base, size, MADV_SEQUENTIAL);
+        }
+        close(fd);
+        return ok;
+    }
+
+public:
+    const char* data = nullptr;
+    std::size_t size = 0;
+};
+
+struct Chunk {
+    const char* begin;
+    const char* end;
+    std::int64_t edges;
+    std::int64_t first;
+    int max;
+};
+
+// about parts chunks, each ending right after a newline or at the end
+std::vector<Chunk> Split(const char* data, std::int64_t size, std::int64_t parts) {
+    std::vector<Chunk> chunks;
+    const char* end = data + size;
+    const char* p = data;
+    for (std::int64_t i = 1; p < end; i++) {
+        const char* q = i < parts ? data + size * i / parts : end;
+        if (q < p)
+            continue;
+        if (q < end) {
+            const void* nl = std::memchr(q, '\n', end - q);
+            q = nl ? static_cast<const char*>(nl) + 1 : end;
+        }
+        chunks.push_back(Chunk{p, q, 0, 0, -1});
+        p = q;
+    }
+    return chunks;
+}
+
+bool Blank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+bool LineEnd(const char* p, const char* end) {
+    return p == end || *p == '\n' || *p == '\r';
+}
+
+// Lemire's SWAR digit check and conversion of 8 little-endian chars
+bool EightDigits(std::uint64_t v) {
+    return !(((v + 0x4646464646464646) | (v - 0x3030303030303030)) & 0x8080808080808080);
+}
+
+std::uint32_t ParseEight(std::uint64_t v) {
+    const std::uint64_t mask = 0x000000FF000000FF;
+    const std::uint64_t mul1 = 100 + (1000000ULL << 32);
+    const std::uint64_t mul2 = 1 + (10000ULL << 32);
+    v -= 0x3030303030303030;
+    v = (v * 10) + (v >> 8);
+    v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+    return static_cast<std::uint32_t>(v);
+}
+
+bool ParseId(const char*& p, const char* end, int& id) {
+    const char* start = p;
+    std::uint64_t x = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    while (end - p >= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        if (!EightDigits(word))
+            break;
+        x = x * 100000000 + ParseEight(word);
+        p += 8;
+        if (x > INT_MAX)
+            return false;
+    }
+#endif
+    while (p < end && static_cast<unsigned>(*p - '0') < 10) {
+        x = x * 10 + (*p - '0');
+        p++;
+        if (x > INT_MAX)
+            return false;
+    }
+    id = static_cast<int>(x);
+    return p != start;
+}
+
+// calls edge(u, v, w) for every edge line, false on a malformed line
+template <bool kWeighted, typename F>
+bool Scan(const char* p, const char* end, F edge) {
+    while (p < end) {
+        while (p < end && Blank(*p)) {
+            p++;
+        }
+        if (p == end)
+            break;
+        if (*p == '#' || *p == '%') {
+            const void* nl = std::memchr(p, '\n', end - p);
+            p = nl ? static_cast<const char*>(nl) + 1 : end;
+            continue;
+        }
+        if (*p == '\n' || *p == '\r') {
+            p++;
+            continue;
+        }
+
+        int u, v;
+        double w = 1;
+        if (!ParseId(p, end, u) || p == end || !Blank(*p))
+            return false;
+        while (p < end && Blank(*p)) {
+            p++;
+        }
+        if (!ParseId(p, end, v))
+            return false;
+        if (kWeighted) {
+            if (p == end || !Blank(*p))
+                return false;
+            while (p < end && Blank(*p)) {
+                p++;
+            }
+            auto r = std::from_chars(p, end, w);
+            if (r.ec != std::errc())
+                return false;
+            p = r.ptr;
+        }
+        if (!LineEnd(p, end) && !Blank(*p))
+            return false;
+        // further columns are ignored
+        const void* nl = std::memchr(p, '\n', end - p);
+        p = nl ? static_cast<const char*>(nl) + 1 : end;
+        edge(u, v, w);
+    }
+    return true;
+}
+
+void ParallelFor(ThreadPool* pool, std::int64_t n, std::int64_t grain, const ThreadPool::Body& body) {
+    if (pool)
+        pool->ParallelFor(n, grain, body);
+    else if (n > 0)
+        body(0, n, 0);
+}
+
+// runs body on every chunk, false if any call failed
+template <typename F>
+bool ForChunks(std::vector<Chunk>& chunks, ThreadPool* pool, F body) {
+    std::atomic<bool> ok{true};
+    ParallelFor(pool, chunks.size(), 1, [&](std::int64_t b, std::int64_t e, int) {
+        for (std::int64_t i = b; i < e; i++) {
+            if (!body(chunks[i]))
+                ok.store(false, std::memory_order_relaxed);
+        }
+    });
+    return ok.load();
+}
+
+std::int64_t CountEdges(int V, bool directed, const std::vector<std::int64_t>& offsets,
+                        const std::vector<int>& targets) {
+    if (directed)
+        return targets.size();
+    std::int64_t loops = 0;
+    for (int u = 0; u < V; u++) {
+        if (std::binary_search(targets.begin() + offsets[u], targets.begin() + offsets[u + 1], u))
+            loops++;
+    }
+    return (static_cast<std::int64_t>(targets.size()) - loops) / 2 + loops;
+}
+
+template <typename W>
+struct Slot {
+    int v;
+    std::int64_t ordinal;
+    W w;
+};
+
+// parsed rows before they are sorted and compacted
+template <typename W, bool kWeighted>
+struct Rows {
+    int V = 0;
+    std::vector<std::int64_t> offsets;
+    std::vector<int> targets;
+    std::vector<W> weights;
+    // position of each slot's line in the file, orders repeated edges
+    std::vector<std::int64_t> ordinals;
+
+    bool Read(const std::string& path, bool directed, ThreadPool* pool, int vertices);
+    void Compact(ThreadPool* pool);
+};
+
+template <typename W, bool kWeighted>
+bool Rows<W, kWeighted>::Read(const std::string& path, bool directed, ThreadPool* pool, int vertices) {
+    MappedText text;
+    if (!text.Open(path))
+        return false;
+    const std::int64_t parts = std::max<std::int64_t>(pool ? pool->Size() * 4 : 1, text.size / kChunkBytes + 1);
+    std::vector<Chunk> chunks = Split(text.data, text.size, parts);
+
+    // pass 0: edges per chunk and the largest id
+    V = vertices;
+    if (vertices < 0 || kWeighted) {
+        bool ok = ForChunks(chunks, pool, [&](Chunk& c) {
+            return Scan<kWeighted>(c.begin, c.end, [&](int u, int v, double) {
+                c.edges++;
+                c.max = std::max(c.max, std::max(u, v));
+            });
+        });
+        int max = -1;
+        std::int64_t first = 0;
+        for (auto& c : chunks) {
+            max = std::max(max, c.max);
+            c.first = first;
+            first += c.edges;
+        }
+        if (!ok || (vertices >= 0 && max >= vertices))
+            return false;
+        if (vertices < 0)
+            V = max + 1;
+    }
+
+    // pass 1: degrees
+    std::unique_ptr<std::atomic<std::int64_t>[]> count(new std::atomic<std::int64_t>[V]);
+    ParallelFor(pool, V, 1 << 16, [&](std::int64_t b, std::int64_t e, int) {
+        for (std::int64_t u = b; u < e; u++) {
+            count[u].store(0, std::memory_order_relaxed);
+        }
+    });
+    bool ok = ForChunks(chunks, pool, [&](Chunk& c) {
+        bool in_range = true;
+        bool parsed = Scan<kWeighted>(c.begin, c.end, [&](int u, int v, double) {
+            if (u >= V || v >= V) {
+                in_range = false;
+                return;
+            }
+            count[u].fetch_add(1, std::memory_order_relaxed);
+            if (!directed && u != v)
+                count[v].fetch_add(1, std::memory_order_relaxed);
+        });
+        return parsed && in_range;
+    });
+    if (!ok)
+        return false;
+
+    offsets.assign(V + 1, 0);
+    for (int u = 0; u < V; u++) {
+        offsets[u + 1] = offsets[u] + count[u].load(std::memory_order_relaxed);
+        count[u].store(offsets[u], std::memory_order_relaxed);
+    }
+
+    // pass 2: scatter, count now holds the row cursors
+    targets.resize(offsets[V]);
+    if (kWeighted) {
+        weights.resize(offsets[V]);
+        ordinals.resize(offsets[V]);
+    }
+    ForChunks(chunks, pool, [&](Chunk& c) {
+        std::int64_t ordinal = c.first;
+        return Scan<kWeighted>(c.begin, c.end, [&](int u, int v, double w) {
+            std::int64_t k = count[u].fetch_add(1, std::memory_order_relaxed);
+            targets[k] = v;
+            if (kWeighted) {
+                weights[k] = static_cast<W>(w);
+                ordinals[k] = ordinal;
+            }
+            if (!directed && u != v) {
+                k = count[v].fetch_add(1, std::memory_order_relaxed);
+                targets[k] = u;
+                if (kWeighted) {
+                    weights[k] = static_cast<W>(w);
+                    ordinals[k] = ordinal;
+                }
+            }
+            ordinal++;
+        });
+    });
+
+    Compact(pool);
+    return true;
+}
+
+// sort and dedup every row in place, then close the gaps
+template <typename W, bool kWeighted>
+void Rows<W, kWeighted>::Compact(ThreadPool* pool) {
+    std::vector<std::int64_t> kept(V + 1, 0);
+    std::vector<std::vector<Slot<W>>> scratch(pool ? pool->Size() : 1);
+    ParallelFor(pool, V, kGrain, [&](std::int64_t b, std::int64_t e, int tid) {
+        for (std::int64_t u = b; u < e; u++) {
+            const std::int64_t first = offsets[u], last = offsets[u + 1];
+            if (!kWeighted) {
+                std::sort(targets.begin() + first, targets.begin() + last);
+                kept[u + 1] = std::unique(targets.begin() + first, targets.begin() + last) - targets.begin() - first;
+                continue;
+            }
+            auto& row = scratch[tid];
+            row.clear();
+            for (std::int64_t k = first; k < last; k++) {
+                row.push_back(Slot<W>{targets[k], ordinals[k], weights[k]});
+            }
+            std::sort(row.begin(), row.end(), [](const Slot<W>& a, const Slot<W>& b) {
+                return a.v < b.v || (a.v == b.v && a.ordinal < b.ordinal);
+            });
+            std::int64_t n = first;
+            for (std::size_t i = 0; i < row.size(); i++) {
+                if (i + 1 < row.size() && row[i + 1].v == row[i].v)
+                    continue;
+                targets[n] = row[i].v;
+                weights[n] = row[i].w;
+                n++;
+            }
+            kept[u + 1] = n - first;
+        }
+    });
+    for (int u = 0; u < V; u++) {
+        kept[u + 1] += kept[u];
+    }
+
+    std::vector<int> packed(kept[V]);
+    std::vector<W> packed_weights(kWeighted ? kept[V] : 0);
+    ParallelFor(pool, V, kGrain, [&](std::int64_t b, std::int64_t e, int) {
+        for (std::int64_t u = b; u < e; u++) {
+            const std::int64_t n = kept[u + 1] - kept[u];
+            std::copy_n(targets.begin() + offsets[u], n, packed.begin() + kept[u]);
+            if (kWeighted)
+                std::copy_n(weights.begin() + offsets[u], n, packed_weights.begin() + kept[u]);
+        }
+    });
+    offsets.swap(kept);
+    targets.swap(packed);
+    weights.swap(packed_weights);
+    ordinals.clear();
+    ordinals.shrink_to_fit();
+}
+
+// edges of the "u v [w]" name lines of one chunk, ids from names
+template <bool kWeighted, typename Index>
+bool ScanNamed(const char* p, const char* end, Index& names, std::vector<Edge>& edges) {
+    std::string token;
+    while (p < end) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        const char* line_end = nl ? nl : end;
+        int ids[2];
+        double w = 1;
+        int n = 0;
+        while (p < line_end && n < (kWeighted ? 3 : 2)) {
+            while (p < line_end && (Blank(*p) || *p == '\r')) {
+                p++;
+            }
+            if (p == line_end || (n == 0 && (*p == '#' || *p == '%')))
+                break;
+            const char* first = p;
+            while (p < line_end && !Blank(*p) && *p != '\r') {
+                p++;
+            }
+            if (n == 2) {
+                auto r = std::from_chars(first, p, w);
+                if (r.ec != std::errc() || r.ptr != p)
+                    return false;
+            }
+            else {
+                token.assign(first, p);
+                ids[n] = names.IndexByName(token.c_str());
+            }
+            n++;
+        }
+        // further columns are ignored
+        if (n == (kWeighted ? 3 : 2))
+            edges.push_back(Edge(ids[0], ids[1], w));
+        else if (n != 0)
+            return false;
+        p = nl ? nl + 1 : end;
+    }
+    return true;
+}
+
+// parses the chunks in parallel, edges come out in file order
+template <bool kWeighted, typename Index>
+bool ReadNamed(const std::string& path, Index& names, ThreadPool* pool, std::vector<Edge>& edges) {
+    MappedText text;
+    if (!text.Open(path))
+        return false;
+    const std::int64_t parts = std::max<std::int64_t>(pool ? pool->Size() * 4 : 1, text.size / kChunkBytes + 1);
+    std::vector<Chunk> chunks = Split(text.data, text.size, parts);
+    std::vector<std::vector<Edge>> found(chunks.size());
+    const bool ok = ForChunks(chunks, pool, [&](Chunk& c) {
+        return ScanNamed<kWeighted>(c.begin, c.end, names, found[&c - chunks.data()]);
+    });
+    if (!ok)
+        return false;
+    edges.clear();
+    for (const auto& list : found) {
+        edges.insert(edges.end(), list.begin(), list.end());
+    }
+    return true;
+}
+} // namespace
+
+bool ReadEdgeList(const std::string& path, CsrGraph& g, bool directed, ThreadPool* pool, int vertices) {
+    Rows<int, false> rows;
+    if (!rows.Read(path, directed, pool, vertices))
+        return false;
+    g.V = rows.V;
+    g.directed = directed;
+    g.offsets.swap(rows.offsets);
+    g.neighbors.swap(rows.targets);
+    g.E = CountEdges(g.V, directed, g.offsets, g.neighbors);
+    return true;
+}
+
+template <typename W>
+bool ReadEdgeList(const std::string& path, WeightedCsrGraph<W>& g, bool directed, ThreadPool* pool, int vertices) {
+    Rows<W, true> rows;
+    if (!rows.Read(path, directed, pool, vertices))
+        return false;
+    g.V = rows.V;
+    g.directed = directed;
+    g.offsets.swap(rows.offsets);
+    g.targets.swap(rows.targets);
+    g.weights.swap(rows.weights);
+    g.E = CountEdges(g.V, directed, g.offsets, g.targets);
+    return true;
+}
+
+template bool ReadEdgeList(const std::string&, WeightedCsrGraph<float>&, bool, ThreadPool*, int);
+template bool ReadEdgeList(const std::string&, WeightedCsrGraph<std::int32_t>&, bool, ThreadPool*, int);
+template bool ReadEdgeList(const std::string&, WeightedCsrGraph<double>&, bool, ThreadPool*, int);
+
+bool ReadEdgeList(const std::string& path, NameIndex& names, CsrGraph& g, bool directed) {
+    std::vector<Edge> edges;
+    if (!ReadNamed<false>(path, names, nullptr, edges))
+        return false;
+    g = CsrGraph(names.Count(), edges, directed);
+    return true;
+}
+
+template <typename W>
+bool ReadEdgeList(const std::string& path, NameIndex& names, WeightedCsrGraph<W>& g, bool directed) {
+    std::vector<Edge> edges;
+    if (!ReadNamed<true>(path, names, nullptr, edges))
+        return false;
+    g = WeightedCsrGraph<W>(names.Count(), edges, directed);
+    return true;
+}
+
+bool ReadEdgeList(const std::string& path, ConcurrentNameIndex& names, CsrGraph& g, bool directed,
+                  ThreadPool* pool) {
+    std::vector<Edge> edges;
+    if (!ReadNamed<false>(path, names, pool, edges))
+        return false;
+    g = CsrGraph(names.Count(), edges, directed);
+    return true;
+}
+
+template <typename W>
+bool ReadEdgeList(const std::string& path, ConcurrentNameIndex& names, WeightedCsrGraph<W>& g, bool directed,
+                  ThreadPool* pool) {
+    std::vector<Edge> edges;
+    if (!ReadNamed<true>(path, names, pool, edges))
+        return false;
+    g = WeightedCsrGraph<W>(names.Count(), edges, directed);
+    return true;
+}
+
+template bool ReadEdgeList(const std::string&, NameIndex&, WeightedCsrGraph<float>&, bool);
+template bool ReadEdgeList(const std::string&, NameIndex&, WeightedCsrGraph<std::int32_t>&, bool);
+template bool ReadEdgeList(const std::string&, NameIndex&, WeightedCsrGraph<double>&, bool);
+template bool ReadEdgeList(const std::string&, ConcurrentNameIndex&, WeightedCsrGraph<float>&, bool, ThreadPool*);
+template bool ReadEdgeList(const std::string&, ConcurrentNameIndex&, WeightedCsrGraph<std::int32_t>&, bool,
+                           ThreadPool*);
+template bool ReadEdgeList(const std::string&, ConcurrentNameIndex&, WeightedCsrGraph<double>&, bool, ThreadPool*);
+
+} // namespace alg
@@ -0,0 +1,61 @@
+#pragma once
+#include <string>
+
+#include "alg/common/thread_pool.h"
+#include "csr.h"
+#include "weighted_csr.h"
+#include "name_index.h"
+#include "concurrent_name_index.h"
+
+namespace alg {
+
+/**
+ * @brief Build a CSR graph from a "u v" text edge list
+ *
+ * The file is mapped and cut into newline aligned chunks that the pool
+ * parses independently: one pass counts degrees into atomic counters, a
+ * second scatters the edges into their rows, and rows are then sorted and
+ * deduplicated in parallel. Ids are read eight digits at a time when the
+ * bytes allow it. Lines starting with # or % are comments, columns after
+ * the used ones are ignored. If vertices is negative an extra pass finds
+ * the largest id, otherwise larger ids fail. g is left untouched on
+ * failure.
+ */
+bool ReadEdgeList(const std::string& path, CsrGraph& g, bool directed = false,
+                  ThreadPool* pool = nullptr, int vertices = -1);
+
+/**
+ * @brief Same for "u v w" lines, a repeated edge keeps its last weight
+ */
+template <typename W>
+bool ReadEdgeList(const std::string& path, WeightedCsrGraph<W>& g, bool directed = false,
+                  ThreadPool* pool = nullptr, int vertices = -1);
+
+/**
+ * @brief "u v" lines of arbitrary names, resolved in file order through names
+ *
+ * Names are any runs of non-blank bytes, columns after the second are
+ * ignored. NameIndex is not thread-safe, so this path is sequential.
+ */
+bool ReadEdgeList(const std::string& path, NameIndex& names, CsrGraph& g, bool directed = false);
+
+/**
+ * @brief Same for "u v w" lines of names
+ */
+template <typename W>
+bool ReadEdgeList(const std::string& path, NameIndex& names, WeightedCsrGraph<W>& g, bool directed = false);
+
+/**
+ * @brief Names resolved by the pool, every chunk of the file at once
+ *
+ * Ids are dense but their order depends on thread timing, see
+ * ConcurrentNameIndex.
+ */
+bool ReadEdgeList(const std::string& path, ConcurrentNameIndex& names, CsrGraph& g, bool directed = false,
+                  ThreadPool* pool = nullptr);
+
+template <typename W>
+bool ReadEdgeList(const std::string& path, ConcurrentNameIndex& names, WeightedCsrGraph<W>& g,
+                  bool directed = false, ThreadPool* pool = nullptr);
+
+} // namespace alg
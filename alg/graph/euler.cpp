@@ -0,0 +1,115 @@
+#include <algorithm>
+
+#include "euler.h"
+
+namespace alg {
+
+Euler::Euler(const GraphView& graph)
+    : g(graph),
+      edge_id(graph.offsets[graph.V], -1),
+      deg(graph.V, 0) {
+    if (g.directed) {
+        for (std::size_t k = 0; k < edge_id.size(); k++) {
+            edge_id[k] = k;
+        }
+        edges = edge_id.size();
+        for (int u = 0; u < g.V; u++) {
+            deg[u] += g.Deg(u);
+            for (int v : g.Adj(u)) {
+                deg[v]--;
+            }
+        }
+    }
+    else {
+        // Rows are sorted, so walking u in ascending order meets the upper
+        // slots (u, v > u) of every row v < u in ascending order as well:
+        // one cursor per row pairs each lower slot with its upper twin.
+        std::vector<std::int64_t> upper(g.V);
+        for (int u = 0; u < g.V; u++) {
+            const auto nodes = g.Adj(u);
+            upper[u] = g.offsets[u] + (std::upper_bound(nodes.begin(), nodes.end(), u) - nodes.begin());
+        }
+        for (int u = 0; u < g.V; u++) {
+            deg[u] = g.Deg(u);
+            for (std::int64_t k = g.offsets[u]; k < g.offsets[u + 1]; k++) {
+                int v = g.neighbors[k];
+                if (v < u) {
+                    edge_id[k] = edge_id[upper[v]++];
+                }
+                else {
+                    edge_id[k] = edges++;
+                    if (v == u)
+                        deg[u]++;
+                }
+            }
+        }
+    }
+    for (int u = 0; u < g.V; u++) {
+        if (!Balanced(u))
+            unbalanced.push_back(u);
+    }
+    cursor.resize(g.V);
+    used.Resize(edges);
+}
+
+bool Euler::Balanced(int u) const {
+    return g.directed ? deg[u] == 0 : deg[u] % 2 == 0;
+}
+
+bool Euler::Exist(int u, int v) const {
+    if (u == v)
+        return unbalanced.empty();
+    // exactly u and v, which sit in the sorted list in id order
+    if (unbalanced.size() != 2 || unbalanced[0] != std::min(u, v) || unbalanced[1] != std::max(u, v))
+        return false;
+    if (g.directed)
+        return deg[u] == 1 && deg[v] == -1;
+    return true;
+}
+
+bool Euler::Path(int u, int v, std::vector<int>& path) {
+    if (u == v)
+        return Circuit(u, path);
+    if (Exist(u, v) && Walk(u, path) && path.back() == v)
+        return true;
+    path.clear();
+    return false;
+}
+
+bool Euler::Circuit(int u, std::vector<int>& path) {
+    if (unbalanced.empty() && (edges == 0 || g.Deg(u) > 0) && Walk(u, path))
+        return true;
+    path.clear();
+    return false;
+}
+
+bool Euler::Walk(int u, std::vector<int>& path) {
+    std::copy(g.offsets, g.offsets + g.V, cursor.begin());
+    used.Reset();
+    path.clear();
+    path.reserve(edges + 1);
+    st.clear();
+    st.push_back(u);
+    while (!st.empty()) {
+        int x = st.back();
+        std::int64_t& k = cursor[x];
+        const std::int64_t end = g.offsets[x + 1];
+        while (k < end && used.Test(edge_id[k])) {
+            k++;
+        }
+        if (k == end) {
+            path.push_back(x);
+            st.pop_back();
+        }
+        else {
+            used.Set(edge_id[k]);
+            st.push_back(g.neighbors[k++]);
+        }
+    }
+    std::reverse(path.begin(), path.end());
+
+    // edges left over belong to another component
+    return static_cast<std::int64_t>(path.size()) == edges + 1;
+}
+
+} // namespace alg
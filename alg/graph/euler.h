@@ -0,0 +1,60 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "alg/common/bitmap.h"
+#include "csr.h"
+
+namespace alg {
+
+/**
+ * @brief Euler paths and circuits by Hierholzer's algorithm in O(V + E)
+ *
+ * Every vertex keeps a cursor into its CSR row and every edge a bit in a
+ * used-edge bitmap, so each edge slot is looked at once per walk. Undirected
+ * edges get one id shared by both of their slots. The unbalanced vertices
+ * are listed once at construction, so the degree conditions cost O(1) per
+ * query. The graph must outlive the engine.
+ */
+class Euler {
+public:
+    explicit Euler(const GraphView& graph);
+
+    /**
+     * @brief Degree condition for a path from u to v, a circuit if u == v
+     */
+    bool Exist(int u, int v) const;
+
+    /**
+     * @brief Euler path from u to v, false and path empty if there is none
+     */
+    bool Path(int u, int v, std::vector<int>& path);
+
+    /**
+     * @brief Euler circuit through u, false and path empty if there is none
+     *
+     * Fails without walking if any vertex is unbalanced or u has no edge
+     * while the graph has some.
+     */
+    bool Circuit(int u, std::vector<int>& path);
+
+private:
+    bool Balanced(int u) const;
+    bool Walk(int u, std::vector<int>& path);
+
+private:
+    GraphView g;
+    // edge id of every CSR slot
+    std::vector<std::int64_t> edge_id;
+    std::int64_t edges = 0;
+    // undirected: degree with self loops counted twice, directed: out - in
+    std::vector<int> deg;
+    // vertices with !Balanced, ascending
+    std::vector<int> unbalanced;
+
+    std::vector<std::int64_t> cursor;
+    Bitmap used;
+    std::vector<int> st;
+};
+
+} // namespace alg
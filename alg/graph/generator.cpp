@@ -0,0 +1,141 @@
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "generator.h"
+
+namespace alg {
+namespace {
+constexpr std::int64_t kGrain = 1 << 14;
+constexpr std::uint64_t kGolden = 0x9e3779b97f4a7c15ull;
+
+std::uint64_t Mix(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// SplitMix64, stream selects an independent sequence for the same seed
+class Rng {
+public:
+    Rng(std::uint64_t seed, std::uint64_t stream)
+        : state(Mix(seed) ^ Mix(stream * kGolden + 1)) {}
+
+    std::uint64_t Next() {
+        return Mix(state += kGolden);
+    }
+    // uniform in [0, 1)
+    double Uniform() {
+        return static_cast<double>(Next() >> 11) * 0x1.0p-53;
+    }
+    // uniform in [0, n)
+    std::uint64_t Below(std::uint64_t n) {
+        return static_cast<std::uint64_t>((static_cast<unsigned __int128>(Next()) * n) >> 64);
+    }
+
+private:
+    std::uint64_t state;
+};
+
+void ParallelFor(ThreadPool* pool, std::int64_t n, const ThreadPool::Body& body) {
+    if (pool)
+        pool->ParallelFor(n, kGrain, body);
+    else if (n > 0)
+        body(0, n, 0);
+}
+} // namespace
+
+std::vector<Edge> RMatEdges(int scale, int edge_factor, std::uint64_t seed, ThreadPool* pool,
+                            double a, double b, double c) {
+    const int V = 1 << scale;
+    const std::int64_t E = static_cast<std::int64_t>(edge_factor) * V;
+    std::vector<Edge> edges(E, Edge(0, 0));
+    ParallelFor(pool, E, [&](std::int64_t begin, std::int64_t end, int) {
+        for (std::int64_t i = begin; i < end; i++) {
+            Rng rng(seed, i);
+            int u = 0, v = 0;
+            for (int level = 0; level < scale; level++) {
+                const double r = rng.Uniform();
+                u <<= 1;
+                v <<= 1;
+                if (r < a)
+                    continue;
+                if (r < a + b)
+                    v |= 1;
+                else if (r < a + b + c)
+                    u |= 1;
+                else {
+                    u |= 1;
+                    v |= 1;
+                }
+            }
+            edges[i] = Edge(u, v, 1.0);
+        }
+    });
+
+    std::vector<int> label(V);
+    std::iota(label.begin(), label.end(), 0);
+    Rng rng(seed, ~std::uint64_t(0));
+    for (int i = V - 1; i > 0; i--) {
+        std::swap(label[i], label[rng.Below(i + 1)]);
+    }
+    ParallelFor(pool, E, [&](std::int64_t begin, std::int64_t end, int) {
+        for (std::int64_t i = begin; i < end; i++) {
+            edges[i].u = label[edges[i].u];
+            edges[i].v = label[edges[i].v];
+        }
+    });
+    return edges;
+}
+
+std::vector<Edge> GridEdges(int rows, int cols, double keep, std::uint64_t seed) {
+    std::vector<Edge> edges;
+    Rng rng(seed, 0);
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            const int u = r * cols + c;
+            if (c + 1 < cols && rng.Uniform() < keep)
+                edges.push_back(Edge(u, u + 1, 1.0));
+            if (r + 1 < rows && rng.Uniform() < keep)
+                edges.push_back(Edge(u, u + cols, 1.0));
+        }
+    }
+    return edges;
+}
+
+std::vector<Edge> GnpEdges(int n, double p, std::uint64_t seed, bool directed) {
+    std::vector<Edge> edges;
+    if (p <= 0 || n < 2)
+        return edges;
+
+    // pairs are numbered row by row, the gap to the next chosen pair is
+    // geometric; undirected rows v hold the pairs (v, w < v)
+    Rng rng(seed, 0);
+    const double log_q = std::log1p(-std::min(p, 1.0));
+    auto skip = [&]() -> std::int64_t {
+        if (p >= 1)
+            return 0;
+        return static_cast<std::int64_t>(std::floor(std::log1p(-rng.Uniform()) / log_q));
+    };
+    std::int64_t v = directed ? 0 : 1, w = -1;
+    while (v < n) {
+        w += 1 + skip();
+        while (v < n && w >= (directed ? n : v)) {
+            w -= directed ? n : v;
+            v++;
+        }
+        if (v < n && !(directed && v == w))
+            edges.push_back(Edge(static_cast<int>(v), static_cast<int>(w), 1.0));
+    }
+    return edges;
+}
+
+void RandomWeights(std::vector<Edge>& edges, int max_weight, std::uint64_t seed) {
+    Rng rng(seed, 1);
+    for (auto& e : edges) {
+        e.w = static_cast<double>(1 + rng.Below(max_weight));
+    }
+}
+
+} // namespace alg
@@ -0,0 +1,48 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "alg/common/thread_pool.h"
+#include "edge.h"
+
+namespace alg {
+
+/**
+ * @brief Seeded synthetic graphs for tests and benchmarks
+ *
+ * Random numbers come from a counter-based SplitMix64 stream, so the same
+ * seed gives the same edges on every platform and for any pool size. The
+ * edge lists may hold self-loops and repeats, the CSR builders drop them.
+ */
+
+/**
+ * @brief R-MAT edges of a 2^scale vertex graph, edge_factor per vertex
+ *
+ * Every edge descends scale levels of the adjacency matrix, picking a
+ * quadrant with probabilities a, b, c and 1 - a - b - c. Vertex ids are
+ * then permuted so that hubs are not clustered at small ids.
+ */
+std::vector<Edge> RMatEdges(int scale, int edge_factor, std::uint64_t seed, ThreadPool* pool = nullptr,
+                            double a = 0.57, double b = 0.19, double c = 0.19);
+
+/**
+ * @brief rows x cols grid with 4-neighbor edges, each kept with
+ *        probability keep; road-like with keep < 1 and random weights
+ */
+std::vector<Edge> GridEdges(int rows, int cols, double keep, std::uint64_t seed);
+
+/**
+ * @brief Erdos-Renyi G(n, p), every pair independently with probability p
+ *
+ * Geometric skipping jumps straight to the next chosen pair, so the cost
+ * is O(n + edges) rather than O(n^2). Directed graphs choose ordered
+ * pairs without self-loops.
+ */
+std::vector<Edge> GnpEdges(int n, double p, std::uint64_t seed, bool directed = false);
+
+/**
+ * @brief Set every weight to a uniform integer in [1, max_weight]
+ */
+void RandomWeights(std::vector<Edge>& edges, int max_weight, std::uint64_t seed);
+
+} // namespace alg
@@ -30,23 +30,26 @@ public:
         return edges;
     }
 
+    /**
+     * @brief E only counts real changes, duplicates and missing edges are no-ops
+     */
     void AddEdge(const Edge& e) {
-        adj[e.u][e.v] = 1;
-        adj[e.v][e.u] = 1;
-        E++;
+        AddEdge(e.u, e.v);
     }
     void AddEdge(int u, int v) {
+        if (adj[u][v] == 1)
+            return;
         adj[u][v] = 1;
         adj[v][u] = 1;
         E++;
     }
 
     void RemoveEdge(const Edge& e) {
-        adj[e.u][e.v] = 0;
-        adj[e.v][e.u] = 0;
-        E--;
+        RemoveEdge(e.u, e.v);
     }
     void RemoveEdge(int u, int v) {
+        if (adj[u][v] == 0)
+            return;
         adj[u][v] = 0;
         adj[v][u] = 0;
         E--;
@@ -102,20 +105,25 @@ public:
         return edges;
     }
 
+    /**
+     * @brief E only counts real changes, duplicates and missing edges are no-ops
+     */
     void AddEdge(const Edge& e) {
-        adj[e.u][e.v] = 1;
-        E++;
+        AddEdge(e.u, e.v);
     }
     void AddEdge(int u, int v) {
+        if (adj[u][v] == 1)
+            return;
         adj[u][v] = 1;
         E++;
     }
 
     void RemoveEdge(const Edge& e) {
-        adj[e.u][e.v] = 0;
-        E--;
+        RemoveEdge(e.u, e.v);
     }
     void RemoveEdge(int u, int v) {
+        if (adj[u][v] == 0)
+            return;
         adj[u][v] = 0;
         E--;
     }
@@ -160,29 +168,31 @@ public:
         for (int i = 0; i < V; i++) {
             for (int j = i + 1; j < V; j++) {
                 if (!IsInf( adj[i][j] ))
-                    edges.push_back(Edge(i, j));
+                    edges.push_back(Edge(i, j, adj[i][j]));
             }
         }
         return edges;
     }
 
+    /**
+     * @brief Add or reweight u-v, E only changes if the edge is new
+     */
     void AddEdge(const Edge& e) {
-        adj[e.u][e.v] = e.w;
-        adj[e.v][e.u] = e.w;
-        E++;
+        AddEdge(e.u, e.v, e.w);
     }
     void AddEdge(int u, int v, double w) {
+        if (IsInf(adj[u][v]))
+            E++;
         adj[u][v] = w;
         adj[v][u] = w;
-        E++;
     }
 
     void RemoveEdge(const Edge& e) {
-        adj[e.u][e.v] = kInf;
-        adj[e.v][e.u] = kInf;
-        E--;
+        RemoveEdge(e.u, e.v);
     }
     void RemoveEdge(int u, int v) {
+        if (IsInf(adj[u][v]))
+            return;
         adj[u][v] = kInf;
         adj[v][u] = kInf;
         E--;
@@ -228,26 +238,30 @@ public:
         for (int i = 0; i < V; i++) {
             for (int j = 0; j < V; j++) {
                 if (!IsInf( adj[i][j] ))
-                    edges.push_back(Edge(i, j));
+                    edges.push_back(Edge(i, j, adj[i][j]));
             }
         }
         return edges;
     }
 
+    /**
+     * @brief Add or reweight u->v, E only changes if the edge is new
+     */
     void AddEdge(const Edge& e) {
-        adj[e.u][e.v] = e.w;
-        E++;
+        AddEdge(e.u, e.v, e.w);
     }
     void AddEdge(int u, int v, double w) {
+        if (IsInf(adj[u][v]))
+            E++;
         adj[u][v] = w;
-        E++;
     }
 
     void RemoveEdge(const Edge& e) {
-        adj[e.u][e.v] = kInf;
-        E--;
+        RemoveEdge(e.u, e.v);
     }
     void RemoveEdge(int u, int v) {
+        if (IsInf(adj[u][v]))
+            return;
         adj[u][v] = kInf;
         E--;
     }
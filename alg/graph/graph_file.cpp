@@ -0,0 +1,458 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "graph_file.h"
+
+namespace alg {
+namespace {
+constexpr char kMagic[8] = {'A', 'L', 'G', 'G', 'R', 'A', 'P', 'H'};
+
+std::int64_t Align(std::int64_t x) {
+    return (x + 63) & ~std::int64_t(63);
+}
+
+std::int64_t WeightSize(GraphFileWeight weight) {
+    switch (weight) {
+    case kFloat32Weight:
+        return sizeof(float);
+    case kInt32Weight:
+        return sizeof(std::int32_t);
+    case kFloat64Weight:
+        return sizeof(double);
+    default:
+        return 0;
+    }
+}
+
+// names < 0 leaves out the name table
+GraphFileHeader Layout(std::int64_t V, std::int64_t slots, bool directed, GraphFileWeight weight,
+                       std::int64_t names) {
+    GraphFileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = GraphFileHeader::kVersion;
+    h.flags = directed ? GraphFileHeader::kDirected : 0;
+    h.weight = weight;
+    h.V = V;
+    h.slots = slots;
+
+    std::int64_t at = Align(sizeof(GraphFileHeader));
+    h.offsets_at = at;
+    at = Align(at + (V + 1) * sizeof(std::int64_t));
+    h.neighbors_at = at;
+    at = Align(at + slots * sizeof(int));
+    if (weight != kNoWeight) {
+        h.weights_at = at;
+        at = Align(at + slots * WeightSize(weight));
+    }
+    if (names >= 0) {
+        h.names_at = at;
+        at += (V + 1) * sizeof(std::int64_t) + names;
+    }
+    h.size = at;
+    return h;
+}
+
+// file of a fixed size mapped for writing, built under a temporary name
+// next to path and renamed over it by Commit; removed if never committed
+class OutputFile {
+public:
+    ~OutputFile() {
+        Unmap();
+        if (!temp.empty())
+            unlink(temp.c_str());
+    }
+
+    bool Create(const std::string& path, std::int64_t bytes) {
+        target = path;
+        size = bytes;
+        std::string name = path + ".XXXXXX";
+        fd = mkstemp(&name[0]);
+        if (fd < 0)
+            return false;
+        temp = name;
+        if (fchmod(fd, 0644) != 0 || ftruncate(fd, size) != 0)
+            return false;
+        base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        return base != MAP_FAILED;
+    }
+
+    template <typename T>
+    T* At(std::int64_t offset) {
+        return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+    }
+
+    bool Commit() {
+        Unmap();
+        if (std::rename(temp.c_str(), target.c_str()) != 0)
+            return false;
+        temp.clear();
+        return true;
+    }
+
+private:
+    void Unmap() {
+        if (base != MAP_FAILED)
+            munmap(base, size);
+        if (fd >= 0)
+            close(fd);
+        base = MAP_FAILED;
+        fd = -1;
+    }
+
+private:
+    std::string target;
+    std::string temp;
+    int fd = -1;
+    void* base = MAP_FAILED;
+    std::size_t size = 0;
+};
+
+bool Write(const std::string& path, const GraphFileHeader& h, const std::int64_t* offsets,
+           const int* neighbors, const void* weights, const std::vector<std::string>* names) {
+    if (names && static_cast<std::int64_t>(names->size()) != h.V)
+        return false;
+    OutputFile out;
+    if (!out.Create(path, h.size))
+        return false;
+    std::memcpy(out.At<GraphFileHeader>(0), &h, sizeof(h));
+    std::memcpy(out.At<std::int64_t>(h.offsets_at), offsets, (h.V + 1) * sizeof(std::int64_t));
+    std::memcpy(out.At<int>(h.neighbors_at), neighbors, h.slots * sizeof(int));
+    if (h.weights_at)
+        std::memcpy(out.At<char>(h.weights_at), weights, h.slots * WeightSize(GraphFileWeight(h.weight)));
+    if (h.names_at) {
+        std::int64_t* at = out.At<std::int64_t>(h.names_at);
+        char* chars = reinterpret_cast<char*>(at + h.V + 1);
+        std::int64_t n = 0;
+        for (std::int64_t u = 0; u < h.V; u++) {
+            at[u] = n;
+            const std::string& name = (*names)[u];
+            std::memcpy(chars + n, name.c_str(), name.size() + 1);
+            n += name.size() + 1;
+        }
+        at[h.V] = n;
+    }
+    return out.Commit();
+}
+
+std::int64_t NameBytes(const std::vector<std::string>* names) {
+    if (!names)
+        return -1;
+    std::int64_t n = 0;
+    for (const auto& name : *names) {
+        n += name.size() + 1;
+    }
+    return n;
+}
+
+// 1 for an edge, 0 for a blank or comment line, -1 if malformed
+int ParseLine(const char* s, std::int64_t& u, std::int64_t& v, double& w, bool weighted) {
+    while (*s == ' ' || *s == '\t') {
+        s++;
+    }
+    if (*s == '\n' || *s == '\r' || *s == 0 || *s == '#' || *s == '%')
+        return 0;
+    char* end;
+    u = std::strtoll(s, &end, 10);
+    if (end == s)
+        return -1;
+    s = end;
+    v = std::strtoll(s, &end, 10);
+    // V = largest id + 1 must fit an int
+    if (end == s || u < 0 || v < 0 || u >= 0x7fffffff || v >= 0x7fffffff)
+        return -1;
+    if (weighted) {
+        s = end;
+        w = std::strtod(s, &end);
+        if (end == s)
+            return -1;
+    }
+    return 1;
+}
+
+// calls edge(u, v, w) for every edge line of the file, lines of any length
+template <typename F>
+bool ForEachEdge(const std::string& path, bool weighted, F edge) {
+    std::FILE* f = std::fopen(path.c_str(), "r");
+    if (!f)
+        return false;
+    char* line = nullptr;
+    std::size_t capacity = 0;
+    bool ok = true;
+    std::int64_t u, v;
+    double w = 1;
+    while (ok && getline(&line, &capacity, f) >= 0) {
+        int r = ParseLine(line, u, v, w, weighted);
+        if (r < 0)
+            ok = false;
+        else if (r > 0)
+            edge(static_cast<int>(u), static_cast<int>(v), w);
+    }
+    std::free(line);
+    std::fclose(f);
+    return ok;
+}
+
+void StoreWeight(void* weights, GraphFileWeight weight, std::int64_t k, double w) {
+    switch (weight) {
+    case kFloat32Weight:
+        static_cast<float*>(weights)[k] = static_cast<float>(w);
+        break;
+    case kInt32Weight:
+        static_cast<std::int32_t*>(weights)[k] = static_cast<std::int32_t>(w);
+        break;
+    case kFloat64Weight:
+        static_cast<double*>(weights)[k] = w;
+        break;
+    default:
+        break;
+    }
+}
+
+// sort rows by target in place, equal targets keep the last weight like
+// WeightedCsrGraph; returns the number of slots left at the front
+template <typename W>
+std::int64_t CompactRows(std::int64_t V, std::int64_t* offsets, int* neighbors, W* weights) {
+    std::vector<std::pair<int, W>> row;
+    std::int64_t n = 0;
+    std::int64_t begin = offsets[0];
+    for (std::int64_t u = 0; u < V; u++) {
+        const std::int64_t end = offsets[u + 1];
+        row.clear();
+        for (std::int64_t k = begin; k < end; k++) {
+            row.emplace_back(neighbors[k], weights ? weights[k] : W());
+        }
+        std::stable_sort(row.begin(), row.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+        offsets[u] = n;
+        for (std::size_t i = 0; i < row.size(); i++) {
+            if (i + 1 < row.size() && row[i + 1].first == row[i].first)
+                continue;
+            neighbors[n] = row[i].first;
+            if (weights)
+                weights[n] = row[i].second;
+            n++;
+        }
+        begin = end;
+    }
+    offsets[V] = n;
+    return n;
+}
+
+// offsets ascend from 0 and every neighbor is a vertex
+bool ValidRows(std::int64_t V, const std::int64_t* offsets, const int* neighbors) {
+    for (std::int64_t u = 0; u < V; u++) {
+        if (offsets[u] > offsets[u + 1])
+            return false;
+    }
+    for (std::int64_t k = 0; k < offsets[V]; k++) {
+        if (neighbors[k] < 0 || neighbors[k] >= V)
+            return false;
+    }
+    return true;
+}
+
+// name offsets ascend from 0 and every name ends in a NUL before the next
+bool ValidNames(std::int64_t V, const std::int64_t* offsets, const char* names) {
+    if (offsets[0] != 0)
+        return false;
+    for (std::int64_t u = 0; u < V; u++) {
+        if (offsets[u] >= offsets[u + 1] || names[offsets[u + 1] - 1] != 0)
+            return false;
+    }
+    return true;
+}
+} // namespace
+
+bool MappedGraph::Open(const std::string& path) {
+    Close();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(GraphFileHeader))) {
+        close(fd);
+        return false;
+    }
+    size = st.st_size;
+    base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        base = nullptr;
+        return false;
+    }
+
+    const char* bytes = static_cast<const char*>(base);
+    GraphFileHeader h;
+    std::memcpy(&h, bytes, sizeof(h));
+    const std::int64_t file = size;
+    // bound V and slots by the file first, so the section sizes cannot wrap
+    const std::int64_t offsets_at = Align(sizeof(GraphFileHeader));
+    const std::int64_t max_V = (file - offsets_at) / static_cast<std::int64_t>(sizeof(std::int64_t)) - 1;
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != GraphFileHeader::kVersion ||
+        h.weight > kFloat64Weight || h.V < 0 || h.V > 0x7fffffff || h.V > max_V) {
+        Close();
+        return false;
+    }
+    const std::int64_t neighbors_at = Align(offsets_at + (h.V + 1) * static_cast<std::int64_t>(sizeof(std::int64_t)));
+    if (h.slots < 0 || h.slots > (file - neighbors_at) / static_cast<std::int64_t>(sizeof(int))) {
+        Close();
+        return false;
+    }
+    const GraphFileHeader expected = Layout(h.V, h.slots, h.flags & GraphFileHeader::kDirected,
+                                            GraphFileWeight(h.weight), h.names_at ? 0 : -1);
+    if (h.offsets_at != expected.offsets_at || h.neighbors_at != expected.neighbors_at ||
+        h.weights_at != expected.weights_at || h.names_at != expected.names_at ||
+        h.size > file || expected.size > file) {
+        Close();
+        return false;
+    }
+
+    V = h.V;
+    E = h.E;
+    directed = h.flags & GraphFileHeader::kDirected;
+    weight = GraphFileWeight(h.weight);
+    offsets = reinterpret_cast<const std::int64_t*>(bytes + h.offsets_at);
+    neighbors = reinterpret_cast<const int*>(bytes + h.neighbors_at);
+    weights = h.weights_at ? bytes + h.weights_at : nullptr;
+    if (offsets[0] != 0 || offsets[V] > h.slots || !ValidRows(V, offsets, neighbors)) {
+        Close();
+        return false;
+    }
+    if (h.names_at) {
+        name_offsets = reinterpret_cast<const std::int64_t*>(bytes + h.names_at);
+        names = reinterpret_cast<const char*>(name_offsets + V + 1);
+        // the table itself fits, see expected.size
+        const std::int64_t room = file - h.names_at - (V + 1) * static_cast<std::int64_t>(sizeof(std::int64_t));
+        if (name_offsets[V] < 0 || name_offsets[V] > room || !ValidNames(V, name_offsets, names)) {
+            Close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void MappedGraph::Close() {
+    if (base)
+        munmap(base, size);
+    base = nullptr;
+    size = 0;
+    V = 0;
+    E = 0;
+    directed = false;
+    offsets = nullptr;
+    neighbors = nullptr;
+    weight = kNoWeight;
+    weights = nullptr;
+    name_offsets = nullptr;
+    names = nullptr;
+}
+
+void MappedGraph::LoadNames(NameIndex& index) const {
+    for (int u = 0; u < V && names; u++) {
+        index.IndexByName(Name(u));
+    }
+}
+
+CsrGraph MappedGraph::Topology() const {
+    return View().Topology();
+}
+
+bool WriteGraphFile(const std::string& path, const CsrGraph& g, const std::vector<std::string>* names) {
+    GraphFileHeader h = Layout(g.V, g.offsets[g.V], g.directed, kNoWeight, NameBytes(names));
+    h.E = g.E;
+    return Write(path, h, g.offsets.data(), g.neighbors.data(), nullptr, names);
+}
+
+template <typename W>
+bool WriteGraphFile(const std::string& path, const WeightedCsrGraph<W>& g, const std::vector<std::string>* names) {
+    GraphFileHeader h = Layout(g.V, g.offsets[g.V], g.directed, GraphFileWeightOf<W>(), NameBytes(names));
+    h.E = g.E;
+    return Write(path, h, g.offsets.data(), g.targets.data(), g.weights.data(), names);
+}
+
+template bool WriteGraphFile(const std::string&, const WeightedCsrGraph<float>&, const std::vector<std::string>*);
+template bool WriteGraphFile(const std::string&, const WeightedCsrGraph<std::int32_t>&, const std::vector<std::string>*);
+template bool WriteGraphFile(const std::string&, const WeightedCsrGraph<double>&, const std::vector<std::string>*);
+
+bool ConvertEdgeList(const std::string& text, const std::string& path, bool directed, GraphFileWeight weight) {
+    const bool weighted = weight != kNoWeight;
+    std::vector<std::int64_t> cursor;
+    bool ok = ForEachEdge(text, weighted, [&](int u, int v, double) {
+        const std::size_t n = static_cast<std::size_t>(std::max(u, v)) + 1;
+        if (cursor.size() < n + 1)
+            cursor.resize(n + 1, 0);
+        cursor[u + 1]++;
+        if (!directed && u != v)
+            cursor[v + 1]++;
+    });
+    if (!ok)
+        return false;
+    if (cursor.empty())
+        cursor.assign(1, 0);
+
+    const std::int64_t V = cursor.size() - 1;
+    for (std::int64_t u = 0; u < V; u++) {
+        cursor[u + 1] += cursor[u];
+    }
+    GraphFileHeader h = Layout(V, cursor[V], directed, weight, -1);
+    OutputFile out;
+    if (!out.Create(path, h.size))
+        return false;
+    std::int64_t* offsets = out.At<std::int64_t>(h.offsets_at);
+    int* neighbors = out.At<int>(h.neighbors_at);
+    void* weights = weighted ? out.At<char>(h.weights_at) : nullptr;
+    std::copy(cursor.begin(), cursor.end(), offsets);
+
+    ok = ForEachEdge(text, weighted, [&](int u, int v, double w) {
+        std::int64_t k = cursor[u]++;
+        neighbors[k] = v;
+        StoreWeight(weights, weight, k, w);
+        if (!directed && u != v) {
+            k = cursor[v]++;
+            neighbors[k] = u;
+            StoreWeight(weights, weight, k, w);
+        }
+    });
+    if (!ok)
+        return false;
+
+    // slots stays the section size, duplicates free its tail
+    std::int64_t used;
+    switch (weight) {
+    case kFloat32Weight:
+        used = CompactRows(V, offsets, neighbors, static_cast<float*>(weights));
+        break;
+    case kInt32Weight:
+        used = CompactRows(V, offsets, neighbors, static_cast<std::int32_t*>(weights));
+        break;
+    case kFloat64Weight:
+        used = CompactRows(V, offsets, neighbors, static_cast<double*>(weights));
+        break;
+    default:
+        used = CompactRows<char>(V, offsets, neighbors, nullptr);
+        break;
+    }
+
+    h.E = used;
+    if (!directed) {
+        std::int64_t loops = 0;
+        for (std::int64_t u = 0; u < V; u++) {
+            if (std::binary_search(neighbors + offsets[u], neighbors + offsets[u + 1], u))
+                loops++;
+        }
+        h.E = (used - loops) / 2 + loops;
+    }
+    std::memcpy(out.At<GraphFileHeader>(0), &h, sizeof(h));
+    return out.Commit();
+}
+
+} // namespace alg
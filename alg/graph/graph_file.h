@@ -0,0 +1,187 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#include "csr.h"
+#include "weighted_csr.h"
+#include "name_index.h"
+
+namespace alg {
+
+enum GraphFileWeight : std::uint32_t {
+    kNoWeight = 0,
+    kFloat32Weight = 1,
+    kInt32Weight = 2,
+    kFloat64Weight = 3,
+};
+
+template <typename W>
+constexpr GraphFileWeight GraphFileWeightOf();
+template <>
+constexpr GraphFileWeight GraphFileWeightOf<float>() {
+    return kFloat32Weight;
+}
+template <>
+constexpr GraphFileWeight GraphFileWeightOf<std::int32_t>() {
+    return kInt32Weight;
+}
+template <>
+constexpr GraphFileWeight GraphFileWeightOf<double>() {
+    return kFloat64Weight;
+}
+
+/**
+ * @brief Header of a binary graph file, followed by 64-byte aligned sections
+ *
+ * offsets is int64[V + 1], neighbors int32[slots], weights W[slots] and the
+ * name table int64[V + 1] offsets into NUL terminated names that follow
+ * it. Rows use the first offsets[V] <= slots entries. A missing section
+ * has offset 0. Everything is in host byte order.
+ */
+struct GraphFileHeader {
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::uint32_t kDirected = 1;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint32_t weight;
+    std::uint32_t reserved;
+    std::int64_t V;
+    std::int64_t E;
+    std::int64_t slots;
+    std::int64_t offsets_at;
+    std::int64_t neighbors_at;
+    std::int64_t weights_at;
+    std::int64_t names_at;
+    std::int64_t size;
+};
+
+/**
+ * @brief Read-only view of a graph file mapped into memory
+ *
+ * Open validates the header and section bounds, then checks in one pass
+ * that the offsets ascend, every neighbor id is below V and every name is
+ * NUL terminated, so no later access leaves the mapping. Nothing is parsed
+ * or copied, the mapping is only pointed into. Rows keep the CsrGraph
+ * layout.
+ */
+class MappedGraph {
+public:
+    MappedGraph() = default;
+    ~MappedGraph() {
+        Close();
+    }
+
+    MappedGraph(const MappedGraph&) = delete;
+    MappedGraph& operator=(const MappedGraph&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const {
+        return base != nullptr;
+    }
+
+    Span<int> Adj(int u) const {
+        return Span<int>(neighbors + offsets[u], neighbors + offsets[u + 1]);
+    }
+    int Deg(int u) const {
+        return static_cast<int>(offsets[u + 1] - offsets[u]);
+    }
+
+    GraphFileWeight WeightType() const {
+        return weight;
+    }
+
+    /**
+     * @brief Weights of row u, empty unless the file stores W
+     */
+    template <typename W>
+    Span<W> Weights(int u) const {
+        if (weight != GraphFileWeightOf<W>())
+            return Span<W>();
+        const W* w = static_cast<const W*>(weights);
+        return Span<W>(w + offsets[u], w + offsets[u + 1]);
+    }
+
+    bool HasNames() const {
+        return names != nullptr;
+    }
+    const char* Name(int u) const {
+        return names + name_offsets[u];
+    }
+
+    /**
+     * @brief Insert all names in id order, so index ids match vertex ids
+     */
+    void LoadNames(NameIndex& index) const;
+
+    /**
+     * @brief Topology without copying, valid while the file is open
+     */
+    GraphView View() const {
+        return GraphView(V, E, directed, offsets, neighbors);
+    }
+
+    /**
+     * @brief Weighted view, false unless the file stores W
+     */
+    template <typename W>
+    bool View(WeightedGraphView<W>& view) const {
+        if (weight != GraphFileWeightOf<W>())
+            return false;
+        view = WeightedGraphView<W>(View(), static_cast<const W*>(weights));
+        return true;
+    }
+
+    /**
+     * @brief Owning copy of the topology
+     */
+    CsrGraph Topology() const;
+
+public:
+    int V = 0;
+    std::int64_t E = 0;
+    bool directed = false;
+    const std::int64_t* offsets = nullptr;
+    const int* neighbors = nullptr;
+
+private:
+    void* base = nullptr;
+    std::size_t size = 0;
+    GraphFileWeight weight = kNoWeight;
+    const void* weights = nullptr;
+    const std::int64_t* name_offsets = nullptr;
+    const char* names = nullptr;
+};
+
+/**
+ * @brief Write g, names (if given) must hold one name per vertex
+ *
+ * The file is built under a temporary name next to path and renamed over
+ * it once complete, so a failure leaves path as it was.
+ */
+bool WriteGraphFile(const std::string& path, const CsrGraph& g,
+                    const std::vector<std::string>* names = nullptr);
+
+template <typename W>
+bool WriteGraphFile(const std::string& path, const WeightedCsrGraph<W>& g,
+                    const std::vector<std::string>* names = nullptr);
+
+/**
+ * @brief Convert a "u v [w]" text edge list to a graph file
+ *
+ * Two streaming passes over the text: the first counts degrees, the second
+ * scatters every edge straight into the mapped output, then each row is
+ * sorted and deduplicated in place. Only O(V) memory is used. Lines
+ * starting with # or % are comments, lines may be of any length, the
+ * vertex count is the largest id plus one, weight is kNoWeight for an
+ * unweighted graph. Like WriteGraphFile, path only changes on success.
+ */
+bool ConvertEdgeList(const std::string& text, const std::string& path, bool directed,
+                     GraphFileWeight weight = kNoWeight);
+
+} // namespace alg
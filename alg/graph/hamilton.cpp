@@ -0,0 +1,236 @@
+#include <algorithm>
+
+#include "hamilton.h"
+
+namespace alg {
+namespace {
+constexpr std::int64_t kLayerGrain = 1 << 12;
+
+int Lowest(std::uint32_t bits) {
+    return __builtin_ctz(bits);
+}
+
+// next larger word with the same number of set bits (Gosper's hack)
+std::uint32_t NextSubset(std::uint32_t s) {
+    const std::uint32_t c = s & (0u - s);
+    const std::uint32_t r = s + c;
+    return (((r ^ s) >> 2) / c) | r;
+}
+
+// the rank-th k-subset in increasing order, by the combinatorial number
+// system: rank = sum over the i-th lowest set bit c_i of C(c_i, i)
+std::uint32_t UnrankSubset(std::int64_t rank, int k, const std::vector<std::vector<std::int64_t>>& choose) {
+    std::uint32_t s = 0;
+    int c = static_cast<int>(choose.size()) - 1;
+    for (int i = k; i >= 1; i--) {
+        while (choose[c][i] > rank) {
+            c--;
+        }
+        rank -= choose[c][i];
+        s |= 1u << c;
+        c--;
+    }
+    return s;
+}
+} // namespace
+
+bool Hamilton::Path(int u, int v, std::vector<int>& path, ThreadPool* pool) {
+    if (g.V <= kMaxHeldKarp)
+        return HeldKarp(u, v, path, pool);
+    return Backtrack(u, v, path);
+}
+
+bool Hamilton::HeldKarp(int u, int v, std::vector<int>& path, ThreadPool* pool) {
+    path.clear();
+    if (u == v) {
+        if (g.V != 1)
+            return false;
+        path.push_back(u);
+        return true;
+    }
+
+    // bit i stands for the i-th vertex other than u and v
+    const int m = g.V - 2;
+    std::vector<int> vertex, bit(g.V, -1);
+    for (int i = 0; i < g.V; i++) {
+        if (i != u && i != v) {
+            bit[i] = vertex.size();
+            vertex.push_back(i);
+        }
+    }
+    // pred[w]: vertices with an edge into w, to_v: into v
+    std::vector<std::uint32_t> pred(m, 0);
+    std::uint32_t from_u = 0, to_v = 0;
+    bool uv = false;
+    for (int i = 0; i < m; i++) {
+        for (int w : g.Adj(vertex[i])) {
+            if (bit[w] != -1)
+                pred[bit[w]] |= 1u << i;
+            else if (w == v)
+                to_v |= 1u << i;
+        }
+    }
+    for (int w : g.Adj(u)) {
+        if (bit[w] != -1)
+            from_u |= 1u << bit[w];
+        uv = uv || w == v;
+    }
+    if (m == 0) {
+        if (uv)
+            path = {u, v};
+        return uv;
+    }
+
+    const std::uint32_t full = (1u << m) - 1;
+    std::vector<std::uint32_t> dp(std::size_t(full) + 1, 0);
+    for (int i = 0; i < m; i++) {
+        if (from_u & (1u << i))
+            dp[1u << i] = 1u << i;
+    }
+    const auto step = [&dp, &pred](std::uint32_t s) {
+        std::uint32_t ends = 0;
+        for (std::uint32_t rest = s; rest; rest &= rest - 1) {
+            int w = Lowest(rest);
+            if (dp[s ^ (1u << w)] & pred[w])
+                ends |= 1u << w;
+        }
+        dp[s] = ends;
+    };
+
+    if (pool && pool->Size() > 1) {
+        // layer k only reads layer k - 1; its C(m, k) subsets are split by
+        // rank and each chunk walks its own run of them
+        std::vector<std::vector<std::int64_t>> choose(m + 1, std::vector<std::int64_t>(m + 1, 0));
+        for (int n = 0; n <= m; n++) {
+            choose[n][0] = 1;
+            for (int k = 1; k <= n; k++) {
+                choose[n][k] = choose[n - 1][k - 1] + (k < n ? choose[n - 1][k] : 0);
+            }
+        }
+        for (int k = 2; k <= m; k++) {
+            pool->ParallelFor(choose[m][k], kLayerGrain, [&](std::int64_t b, std::int64_t e, int) {
+                std::uint32_t s = UnrankSubset(b, k, choose);
+                for (std::int64_t r = b; r < e; r++) {
+                    step(s);
+                    if (r + 1 < e)
+                        s = NextSubset(s);
+                }
+            });
+        }
+    }
+    else {
+        // every subset is smaller than its superset
+        for (std::uint32_t s = 1; s <= full; s++) {
+            if (s & (s - 1))
+                step(s);
+        }
+    }
+
+    std::uint32_t ends = dp[full] & to_v;
+    if (!ends)
+        return false;
+
+    path.push_back(v);
+    std::uint32_t s = full;
+    int w = Lowest(ends);
+    while (true) {
+        path.push_back(vertex[w]);
+        std::uint32_t prev = s ^ (1u << w);
+        if (!prev)
+            break;
+        w = Lowest(dp[prev] & pred[w]);
+        s = prev;
+    }
+    path.push_back(u);
+    std::reverse(path.begin(), path.end());
+    return true;
+}
+
+bool Hamilton::Backtrack(int u, int v, std::vector<int>& path) {
+    path.clear();
+    if (u == v) {
+        if (g.V != 1)
+            return false;
+        path.push_back(u);
+        return true;
+    }
+
+    visited.Resize(g.V);
+    reached.Resize(g.V);
+    queue.resize(g.V);
+    // a path visits each vertex once, so its rows fit side by side
+    candidates.resize(g.offsets[g.V]);
+    path.reserve(g.V);
+    visited.Set(u);
+    path.push_back(u);
+    if (BacktrackR(u, v, g.V - 1, 0, path))
+        return true;
+    path.clear();
+    return false;
+}
+
+bool Hamilton::BacktrackR(int x, int v, int left, std::int64_t top, std::vector<int>& path) {
+    if (left == 0)
+        return x == v;
+    if (!Feasible(x, v, left))
+        return false;
+
+    // fewest free neighbors first, v only as the very last vertex; the
+    // candidates of x sit on top of those of the vertices before it
+    std::pair<int, int>* next = candidates.data() + top;
+    int n = 0;
+    for (int w : g.Adj(x)) {
+        if (visited.Test(w) || (w == v && left > 1))
+            continue;
+        int free = 0;
+        for (int y : g.Adj(w)) {
+            free += !visited.Test(y);
+        }
+        next[n++] = std::make_pair(free, w);
+    }
+    std::sort(next, next + n);
+
+    for (int i = 0; i < n; i++) {
+        int w = next[i].second;
+        visited.Set(w);
+        path.push_back(w);
+        if (BacktrackR(w, v, left - 1, top + n, path))
+            return true;
+        path.pop_back();
+        visited.Clear(w);
+    }
+    return false;
+}
+
+/**
+ * The unvisited vertices must all be reachable from x without passing
+ * visited ones. Undirected, every one of them but v needs two usable
+ * neighbors (free or x) to be passed through, and v needs one to be
+ * entered. Directed, reaching a vertex already gives it a way in, and all
+ * but v need an edge out to another free vertex.
+ */
+bool Hamilton::Feasible(int x, int v, int left) {
+    reached.Reset();
+    int head = 0, tail = 0;
+    queue[tail++] = x;
+    reached.Set(x);
+    const int need = g.directed ? 1 : 2;
+    while (head < tail) {
+        int y = queue[head++];
+        int usable = 0;
+        for (int w : g.Adj(y)) {
+            if (w == y || (visited.Test(w) && w != x) || (g.directed && w == x))
+                continue;
+            usable++;
+            if (!reached.Test(w)) {
+                reached.Set(w);
+                queue[tail++] = w;
+            }
+        }
+        if (y != x && usable < (y == v ? need - 1 : need))
+            return false;
+    }
+    return tail - 1 == left;
+}
+
+} // namespace alg
@@ -0,0 +1,60 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "alg/common/bitmap.h"
+#include "alg/common/thread_pool.h"
+#include "csr.h"
+
+namespace alg {
+
+/**
+ * @brief Hamilton path search
+ *
+ * Small graphs use a Held-Karp bitset DP: dp[S] is the set of vertices w
+ * such that some path from u through exactly S ends in w, kept as one word
+ * so that dp[S - w] & pred[w] tests every predecessor at once. Larger graphs
+ * use backtracking pruned by degree and connectivity of the unvisited part.
+ * Directed graphs are followed along their edges, pred[w] being the
+ * vertices with an edge into w.
+ */
+class Hamilton {
+public:
+    // dp table is 2^(V - 2) words
+    static constexpr int kMaxHeldKarp = 28;
+
+    explicit Hamilton(const GraphView& graph)
+        : g(graph) {}
+
+    /**
+     * @brief Hamilton path from u to v, DP when V is small enough
+     */
+    bool Path(int u, int v, std::vector<int>& path, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Held-Karp DP, layers of equal |S| are split over the pool
+     */
+    bool HeldKarp(int u, int v, std::vector<int>& path, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Pruned backtracking, for any V
+     */
+    bool Backtrack(int u, int v, std::vector<int>& path);
+
+private:
+    bool BacktrackR(int x, int v, int left, std::int64_t top, std::vector<int>& path);
+    bool Feasible(int x, int v, int left);
+
+private:
+    GraphView g;
+
+    // backtracking state
+    Bitmap visited;
+    std::vector<int> queue;
+    Bitmap reached;
+    // (free neighbors, vertex) candidates of every depth, stacked
+    std::vector<std::pair<int, int>> candidates;
+};
+
+} // namespace alg
@@ -250,4 +250,31 @@ Graph Graph_7() {
     return g;
 }
 
+/**
+//     0 ----5---- 1 ----1---- 2
+//     | \         |          / |
+//     4   9       2        3   6
+//     |     \     |      /     |
+//     3 --2-- 4 --7-- 5 ---1--- 6
+//                     |
+//                     8
+//                     |
+//                     7
+*/
+WeightedGraph WeightedGraph_1() {
+    WeightedGraph g(8);
+    g.AddEdge(0, 1, 5);
+    g.AddEdge(0, 3, 4);
+    g.AddEdge(0, 4, 9);
+    g.AddEdge(1, 2, 1);
+    g.AddEdge(1, 5, 2);
+    g.AddEdge(2, 5, 3);
+    g.AddEdge(2, 6, 6);
+    g.AddEdge(3, 4, 2);
+    g.AddEdge(4, 5, 7);
+    g.AddEdge(5, 6, 1);
+    g.AddEdge(5, 7, 8);
+    return g;
+}
+
 } // namespace alg
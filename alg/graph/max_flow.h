@@ -0,0 +1,444 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+#include "edge.h"
+#include "graph.h"
+#include "weighted_csr.h"
+
+namespace alg {
+
+/**
+ * @brief Maximum s-t flow and minimum cut over a residual graph
+ *
+ * Every input edge i becomes a forward arc arc[i] and a reverse arc
+ * rev[arc[i]] of capacity 0, both stored CSR-style by tail, so an arc's
+ * partner is found in O(1) and a push updates two cells. Edge i is the
+ * i-th edge of the list, of g.Edges() for a graph; an undirected graph is
+ * used in both directions, with the reverse of edge i at i + |Edges()|.
+ * Capacities must be non-negative.
+ *
+ * The flow persists between runs: SetCapacity changes one edge, keeping the
+ * flow feasible, and the next run for the same s and t starts from that
+ * flow instead of from zero. A run for another s or t starts over.
+ */
+template <typename W>
+class MaxFlow {
+public:
+    using Amount = typename std::conditional<std::is_integral<W>::value, std::int64_t, W>::type;
+
+    MaxFlow(int vertices, const std::vector<Edge>& edges)
+        : V(vertices),
+          offsets(vertices + 1, 0) {
+        const std::int64_t m = static_cast<std::int64_t>(edges.size());
+        for (const auto& e : edges) {
+            offsets[e.u + 1]++;
+            offsets[e.v + 1]++;
+        }
+        for (int u = 0; u < V; u++) {
+            offsets[u + 1] += offsets[u];
+        }
+        head.resize(2 * m);
+        rev.resize(2 * m);
+        capacity.resize(2 * m);
+        arc.resize(m);
+        std::vector<std::int64_t> fill(offsets.begin(), offsets.end() - 1);
+        for (std::int64_t i = 0; i < m; i++) {
+            const Edge& e = edges[i];
+            const std::int64_t a = fill[e.u]++;
+            const std::int64_t b = fill[e.v]++;
+            head[a] = e.v;
+            head[b] = e.u;
+            rev[a] = b;
+            rev[b] = a;
+            capacity[a] = static_cast<W>(e.w);
+            capacity[b] = 0;
+            arc[i] = a;
+        }
+        residual = capacity;
+    }
+    explicit MaxFlow(const DirectedWeightedGraph& g)
+        : MaxFlow(g.V, g.Edges()) {}
+    explicit MaxFlow(const WeightedGraphView<W>& g)
+        : MaxFlow(g.V, BothWays(g)) {}
+
+    int Tail(std::int64_t a) const {
+        return head[rev[a]];
+    }
+
+    /**
+     * @brief Flow on edge i
+     */
+    W Flow(int i) const {
+        return residual[rev[arc[i]]];
+    }
+
+    /**
+     * @brief Net flow out of the source of the last run
+     */
+    Amount Value() const {
+        Amount value = 0;
+        if (source < 0)
+            return value;
+        for (std::int64_t a = offsets[source]; a < offsets[source + 1]; a++) {
+            value += static_cast<Amount>(capacity[a]) - residual[a];
+        }
+        return value;
+    }
+
+    /**
+     * @brief Zero flow everywhere
+     */
+    void Reset() {
+        residual = capacity;
+    }
+
+    /**
+     * @brief FIFO push-relabel with global relabeling and the gap heuristic
+     *
+     * Single phase: heights below V are distances to t, vertices cut off
+     * from t climb above V and return their excess to s, so the result is
+     * a flow, not just a preflow. Heights are recomputed by a backward
+     * breadth-first search from t and s after every V relabels, and when a
+     * height below V empties every vertex above it is lifted past V at once.
+     * O(V^2 sqrt(E)) worst case.
+     */
+    Amount PushRelabel(int s, int t) {
+        Prepare(s, t);
+        if (s == t)
+            return 0;
+        excess.assign(V, 0);
+        height.assign(V, 0);
+        current.assign(offsets.begin(), offsets.end() - 1);
+        queued.assign(V, 0);
+        pending.clear();
+        for (std::int64_t a = offsets[s]; a < offsets[s + 1]; a++) {
+            if (residual[a] > 0)
+                Push(a, residual[a]);
+        }
+        GlobalRelabel();
+        for (int v = 0; v < V; v++) {
+            if (excess[v] > 0 && v != s && v != t && height[v] < 2 * V)
+                Activate(v);
+        }
+        // FIFO by passes: vertices activated during a pass run in the next
+        while (!pending.empty()) {
+            active.swap(pending);
+            pending.clear();
+            for (int v : active) {
+                queued[v] = 0;
+                Discharge(v);
+            }
+        }
+        return Value();
+    }
+
+    /**
+     * @brief Dinic's blocking flows on breadth-first level graphs
+     *
+     * O(V^2 E) in general, O(E min(V^(2/3), E^(1/2))) when every capacity
+     * is 1, where it usually beats push-relabel.
+     */
+    Amount Dinic(int s, int t) {
+        Prepare(s, t);
+        if (s == t)
+            return 0;
+        std::vector<std::int64_t> path;
+        while (Levels(s, t)) {
+            current.assign(offsets.begin(), offsets.end() - 1);
+            int v = s;
+            while (true) {
+                if (v == t) {
+                    W bottleneck = residual[path[0]];
+                    for (std::int64_t a : path) {
+                        bottleneck = std::min(bottleneck, residual[a]);
+                    }
+                    std::size_t first = path.size();
+                    for (std::size_t k = 0; k < path.size(); k++) {
+                        residual[path[k]] -= bottleneck;
+                        residual[rev[path[k]]] += bottleneck;
+                        if (residual[path[k]] == 0 && first == path.size())
+                            first = k;
+                    }
+                    // resume from the tail of the first saturated arc
+                    v = Tail(path[first]);
+                    path.resize(first);
+                    continue;
+                }
+                std::int64_t& a = current[v];
+                while (a < offsets[v + 1] && (residual[a] <= 0 || level[head[a]] != level[v] + 1)) {
+                    a++;
+                }
+                if (a < offsets[v + 1]) {
+                    path.push_back(a);
+                    v = head[a];
+                    continue;
+                }
+                // dead end, retreat
+                level[v] = -1;
+                if (v == s)
+                    break;
+                v = Tail(path.back());
+                path.pop_back();
+                current[v]++;
+            }
+        }
+        return Value();
+    }
+
+    /**
+     * @brief Change the capacity of edge i, false if i or the capacity is
+     *        invalid
+     *
+     * Flow above the new capacity is first rerouted around the edge, and
+     * what cannot be is sent back to the source and taken back from the
+     * sink, so the flow stays feasible and the next run only makes up the
+     * difference.
+     */
+    bool SetCapacity(int i, W c) {
+        if (i < 0 || i >= static_cast<int>(arc.size()) || c < 0)
+            return false;
+        const std::int64_t a = arc[i];
+        const W flow = residual[rev[a]];
+        capacity[a] = c;
+        if (flow <= c) {
+            residual[a] = c - flow;
+            return true;
+        }
+        residual[a] = 0;
+        residual[rev[a]] = c;
+        const int u = Tail(a);
+        const int v = head[a];
+        W surplus = flow - c;
+        surplus -= Reroute(u, v, surplus);
+        if (surplus > 0) {
+            Reroute(u, source, surplus);
+            Reroute(sink, v, surplus);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Source side of a minimum cut: vertices reachable from s in the
+     *        residual graph after a run
+     */
+    std::vector<char> MinCut() const {
+        std::vector<char> side(V, 0);
+        if (source < 0)
+            return side;
+        std::vector<int> queue(1, source);
+        side[source] = 1;
+        for (std::size_t k = 0; k < queue.size(); k++) {
+            const int u = queue[k];
+            for (std::int64_t a = offsets[u]; a < offsets[u + 1]; a++) {
+                if (residual[a] > 0 && !side[head[a]]) {
+                    side[head[a]] = 1;
+                    queue.push_back(head[a]);
+                }
+            }
+        }
+        return side;
+    }
+
+    /**
+     * @brief Edges from the source side to the sink side, saturated, their
+     *        capacities sum to Value()
+     */
+    std::vector<int> CutEdges() const {
+        const std::vector<char> side = MinCut();
+        std::vector<int> edges;
+        for (int i = 0; i < static_cast<int>(arc.size()); i++) {
+            if (side[Tail(arc[i])] && !side[head[arc[i]]])
+                edges.push_back(i);
+        }
+        return edges;
+    }
+
+public:
+    int V;
+    // residual graph, arcs of u are [offsets[u], offsets[u + 1])
+    std::vector<std::int64_t> offsets;
+    std::vector<int> head;
+    std::vector<std::int64_t> rev;
+    std::vector<W> capacity;
+    std::vector<W> residual;
+    // forward arc of every input edge
+    std::vector<std::int64_t> arc;
+
+private:
+    static std::vector<Edge> BothWays(const WeightedGraphView<W>& g) {
+        std::vector<Edge> edges = g.Edges();
+        if (!g.directed) {
+            const std::size_t m = edges.size();
+            for (std::size_t i = 0; i < m; i++) {
+                edges.push_back(Edge(edges[i].v, edges[i].u, edges[i].w));
+            }
+        }
+        return edges;
+    }
+
+    void Prepare(int s, int t) {
+        if (s != source || t != sink)
+            Reset();
+        source = s;
+        sink = t;
+    }
+
+    void Push(std::int64_t a, W delta) {
+        residual[a] -= delta;
+        residual[rev[a]] += delta;
+        excess[Tail(a)] -= delta;
+        excess[head[a]] += delta;
+    }
+
+    void Activate(int v) {
+        if (!queued[v]) {
+            queued[v] = 1;
+            pending.push_back(v);
+        }
+    }
+
+    void Discharge(int v) {
+        while (excess[v] > 0 && height[v] < 2 * V) {
+            std::int64_t& a = current[v];
+            if (a == offsets[v + 1]) {
+                Relabel(v);
+                if (++relabels >= V)
+                    GlobalRelabel();
+                continue;
+            }
+            const int w = head[a];
+            if (residual[a] > 0 && height[v] == height[w] + 1) {
+                const W delta = static_cast<W>(std::min<Amount>(excess[v], residual[a]));
+                Push(a, delta);
+                if (w != source && w != sink)
+                    Activate(w);
+                if (residual[a] == 0)
+                    a++;
+            }
+            else {
+                a++;
+            }
+        }
+    }
+
+    void Relabel(int v) {
+        const int old = height[v];
+        int low = 2 * V;
+        for (std::int64_t a = offsets[v]; a < offsets[v + 1]; a++) {
+            if (residual[a] > 0)
+                low = std::min(low, height[head[a]] + 1);
+        }
+        count[old]--;
+        height[v] = low;
+        count[low]++;
+        current[v] = offsets[v];
+        if (old < V && count[old] == 0) {
+            // gap: nothing above old reaches the sink any more
+            for (int x = 0; x < V; x++) {
+                if (height[x] > old && height[x] < V) {
+                    count[height[x]]--;
+                    height[x] = V + 1;
+                    count[V + 1]++;
+                    current[x] = offsets[x];
+                }
+            }
+        }
+    }
+
+    // exact heights: distance to the sink, else V + distance to the source
+    void GlobalRelabel() {
+        relabels = 0;
+        height.assign(V, 2 * V);
+        height[source] = V;
+        height[sink] = 0;
+        std::vector<int> queue;
+        for (int root : {sink, source}) {
+            queue.assign(1, root);
+            for (std::size_t k = 0; k < queue.size(); k++) {
+                const int x = queue[k];
+                for (std::int64_t a = offsets[x]; a < offsets[x + 1]; a++) {
+                    const int y = head[a];
+                    if (height[y] == 2 * V && residual[rev[a]] > 0) {
+                        height[y] = height[x] + 1;
+                        queue.push_back(y);
+                    }
+                }
+            }
+        }
+        count.assign(2 * V + 1, 0);
+        for (int x = 0; x < V; x++) {
+            count[height[x]]++;
+            current[x] = offsets[x];
+        }
+    }
+
+    // breadth-first levels from s, true if t is reached
+    bool Levels(int s, int t) {
+        level.assign(V, -1);
+        level[s] = 0;
+        std::vector<int> queue(1, s);
+        for (std::size_t k = 0; k < queue.size(); k++) {
+            const int u = queue[k];
+            for (std::int64_t a = offsets[u]; a < offsets[u + 1]; a++) {
+                if (residual[a] > 0 && level[head[a]] == -1) {
+                    level[head[a]] = level[u] + 1;
+                    queue.push_back(head[a]);
+                }
+            }
+        }
+        return level[t] != -1;
+    }
+
+    // moves up to limit units from x to y along shortest residual paths
+    W Reroute(int x, int y, W limit) {
+        if (x == y)
+            return limit;
+        W moved = 0;
+        std::vector<std::int64_t> via(V);
+        std::vector<int> queue;
+        while (moved < limit) {
+            std::fill(via.begin(), via.end(), -1);
+            queue.assign(1, x);
+            for (std::size_t k = 0; k < queue.size() && via[y] == -1; k++) {
+                const int u = queue[k];
+                for (std::int64_t a = offsets[u]; a < offsets[u + 1]; a++) {
+                    const int w = head[a];
+                    if (residual[a] > 0 && w != x && via[w] == -1) {
+                        via[w] = a;
+                        queue.push_back(w);
+                    }
+                }
+            }
+            if (via[y] == -1)
+                break;
+            W bottleneck = limit - moved;
+            for (int w = y; w != x; w = Tail(via[w])) {
+                bottleneck = std::min(bottleneck, residual[via[w]]);
+            }
+            for (int w = y; w != x; w = Tail(via[w])) {
+                residual[via[w]] -= bottleneck;
+                residual[rev[via[w]]] += bottleneck;
+            }
+            moved += bottleneck;
+        }
+        return moved;
+    }
+
+private:
+    int source = -1;
+    int sink = -1;
+    int relabels = 0;
+    std::vector<Amount> excess;
+    std::vector<int> height;
+    std::vector<int> count;
+    std::vector<int> level;
+    std::vector<std::int64_t> current;
+    std::vector<char> queued;
+    std::vector<int> active;
+    std::vector<int> pending;
+};
+
+} // namespace alg
@@ -0,0 +1,277 @@
+#include <atomic>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+
+#include "alg/data/indexed_heap.h"
+#include "components.h"
+#include "mst.h"
+
+namespace alg {
+namespace {
+constexpr std::int64_t kGrain = 4096;
+constexpr int kRadixBits = 8;
+constexpr int kRadix = 1 << kRadixBits;
+
+void ParallelFor(ThreadPool* pool, std::int64_t n, const ThreadPool::Body& body) {
+    if (pool)
+        pool->ParallelFor(n, kGrain, body);
+    else if (n > 0)
+        body(0, n, 0);
+}
+
+// unsigned key with the same order as the double, -0 and 0 are one key
+std::uint64_t OrderKey(double w) {
+    if (w == 0)
+        w = 0;
+    std::uint64_t bits;
+    std::memcpy(&bits, &w, sizeof(bits));
+    return (bits >> 63) ? ~bits : bits | (std::uint64_t(1) << 63);
+}
+
+struct KeyId {
+    std::uint64_t key;
+    std::int64_t id;
+};
+
+// stable LSD radix sort of a by key; chunk c of a pass always covers the
+// same range, so its histogram fixes where each of its items goes
+void RadixSort(std::vector<KeyId>& a, ThreadPool* pool) {
+    const std::int64_t n = a.size();
+    const int chunks = pool && n > kGrain ? pool->Size() : 1;
+    const std::int64_t step = (n + chunks - 1) / chunks;
+    std::vector<KeyId> aux(n);
+    std::vector<std::int64_t> count(static_cast<std::size_t>(chunks) * kRadix);
+
+    auto for_chunks = [&](const std::function<void(int, std::int64_t, std::int64_t)>& body) {
+        auto run = [&](std::int64_t begin, std::int64_t end, int) {
+            for (std::int64_t c = begin; c < end; c++) {
+                body(c, c * step, std::min(n, (c + 1) * step));
+            }
+        };
+        if (chunks > 1)
+            pool->ParallelFor(chunks, 1, run);
+        else
+            run(0, 1, 0);
+    };
+
+    for (int shift = 0; shift < 64; shift += kRadixBits) {
+        std::fill(count.begin(), count.end(), 0);
+        for_chunks([&](int c, std::int64_t begin, std::int64_t end) {
+            std::int64_t* h = &count[c * kRadix];
+            for (std::int64_t i = begin; i < end; i++) {
+                h[(a[i].key >> shift) & (kRadix - 1)]++;
+            }
+        });
+
+        // exclusive prefix over (digit, chunk), skip a pass with one digit
+        bool single = false;
+        std::int64_t sum = 0;
+        for (int d = 0; d < kRadix; d++) {
+            std::int64_t total = 0;
+            for (int c = 0; c < chunks; c++) {
+                std::int64_t k = count[c * kRadix + d];
+                count[c * kRadix + d] = sum;
+                sum += k;
+                total += k;
+            }
+            if (total == n)
+                single = true;
+        }
+        if (single)
+            continue;
+
+        for_chunks([&](int c, std::int64_t begin, std::int64_t end) {
+            std::int64_t* h = &count[c * kRadix];
+            for (std::int64_t i = begin; i < end; i++) {
+                aux[h[(a[i].key >> shift) & (kRadix - 1)]++] = a[i];
+            }
+        });
+        a.swap(aux);
+    }
+}
+
+std::vector<KeyId> Keys(const std::vector<Edge>& edges, ThreadPool* pool) {
+    std::vector<KeyId> keys(edges.size());
+    ParallelFor(pool, edges.size(), [&](std::int64_t b, std::int64_t e, int) {
+        for (std::int64_t i = b; i < e; i++) {
+            keys[i] = KeyId{OrderKey(edges[i].w), i};
+        }
+    });
+    return keys;
+}
+} // namespace
+
+SpanningForest Kruskal(int V, const std::vector<Edge>& edges, ThreadPool* pool) {
+    std::vector<KeyId> order = Keys(edges, pool);
+    RadixSort(order, pool);
+
+    SpanningForest forest;
+    UnionFind uf(V);
+    for (const auto& k : order) {
+        if (uf.Count() == 1)
+            break;
+        const Edge& e = edges[k.id];
+        if (uf.Union(e.u, e.v)) {
+            forest.edges.push_back(e);
+            forest.weight += e.w;
+        }
+    }
+    return forest;
+}
+
+SpanningForest Boruvka(int V, const std::vector<Edge>& edges, ThreadPool* pool) {
+    const std::vector<KeyId> keys = Keys(edges, pool);
+    auto less = [&](std::int64_t a, std::int64_t b) {
+        return keys[a].key < keys[b].key || (keys[a].key == keys[b].key && a < b);
+    };
+
+    ConcurrentUnionFind uf(V);
+    std::unique_ptr<std::atomic<std::int64_t>[]> best(new std::atomic<std::int64_t>[V]);
+    for (int u = 0; u < V; u++) {
+        best[u].store(-1, std::memory_order_relaxed);
+    }
+    auto pick = [&](int r, std::int64_t id) {
+        std::int64_t cur = best[r].load(std::memory_order_relaxed);
+        while (cur == -1 || less(id, cur)) {
+            if (best[r].compare_exchange_weak(cur, id, std::memory_order_relaxed))
+                break;
+        }
+    };
+
+    const int threads = pool ? pool->Size() : 1;
+    std::vector<std::vector<std::int64_t>> locals(threads);
+    std::vector<std::int64_t> picked;
+    std::vector<std::int64_t> live;
+    for (std::size_t i = 0; i < edges.size(); i++) {
+        if (edges[i].u != edges[i].v)
+            live.push_back(i);
+    }
+
+    while (!live.empty()) {
+        ParallelFor(pool, live.size(), [&](std::int64_t b, std::int64_t e, int) {
+            for (std::int64_t i = b; i < e; i++) {
+                const Edge& edge = edges[live[i]];
+                int ru = uf.Find(edge.u), rv = uf.Find(edge.v);
+                if (ru == rv)
+                    continue;
+                pick(ru, live[i]);
+                pick(rv, live[i]);
+            }
+        });
+
+        ParallelFor(pool, V, [&](std::int64_t b, std::int64_t e, int tid) {
+            for (std::int64_t r = b; r < e; r++) {
+                std::int64_t id = best[r].load(std::memory_order_relaxed);
+                if (id == -1)
+                    continue;
+                best[r].store(-1, std::memory_order_relaxed);
+                // both ends may pick the same edge, only one union succeeds
+                if (uf.Union(edges[id].u, edges[id].v))
+                    locals[tid].push_back(id);
+            }
+        });
+        std::size_t before = picked.size();
+        for (auto& local : locals) {
+            picked.insert(picked.end(), local.begin(), local.end());
+            local.clear();
+        }
+        if (picked.size() == before)
+            break;
+
+        ParallelFor(pool, live.size(), [&](std::int64_t b, std::int64_t e, int tid) {
+            for (std::int64_t i = b; i < e; i++) {
+                const Edge& edge = edges[live[i]];
+                if (uf.Find(edge.u) != uf.Find(edge.v))
+                    locals[tid].push_back(live[i]);
+            }
+        });
+        live.clear();
+        for (auto& local : locals) {
+            live.insert(live.end(), local.begin(), local.end());
+            local.clear();
+        }
+    }
+
+    std::sort(picked.begin(), picked.end(), less);
+    SpanningForest forest;
+    forest.edges.reserve(picked.size());
+    for (std::int64_t id : picked) {
+        forest.edges.push_back(edges[id]);
+        forest.weight += edges[id].w;
+    }
+    return forest;
+}
+
+template <typename W>
+SpanningForest Prim(const WeightedGraphView<W>& g) {
+    const int V = g.V;
+    std::vector<W> key(V);
+    std::vector<int> parent(V, -1);
+    std::vector<char> done(V, 0);
+    QuadHeap<W> heap(V);
+
+    SpanningForest forest;
+    for (int root = 0; root < V; root++) {
+        if (done[root])
+            continue;
+        heap.Push(root, W(0));
+        while (!heap.Empty()) {
+            W k;
+            int u = heap.Pop(k);
+            done[u] = 1;
+            if (parent[u] != -1) {
+                forest.edges.push_back(Edge(parent[u], u, k));
+                forest.weight += k;
+            }
+            for (const auto& a : g.Edges(u)) {
+                if (done[a.v])
+                    continue;
+                if (!heap.Contains(a.v) || a.w < key[a.v]) {
+                    key[a.v] = a.w;
+                    parent[a.v] = u;
+                    heap.Push(a.v, a.w);
+                }
+            }
+        }
+    }
+    return forest;
+}
+
+SpanningForest Prim(const WeightedGraph& g) {
+    const int V = g.V;
+    std::vector<double> key(V, kInf);
+    std::vector<int> parent(V, -1);
+    std::vector<char> done(V, 0);
+
+    SpanningForest forest;
+    for (int n = 0; n < V; n++) {
+        // closest vertex outside the tree, a new root if all are kInf
+        int u = -1;
+        for (int v = 0; v < V; v++) {
+            if (!done[v] && (u == -1 || key[v] < key[u]))
+                u = v;
+        }
+        done[u] = 1;
+        if (parent[u] != -1) {
+            forest.edges.push_back(Edge(parent[u], u, key[u]));
+            forest.weight += key[u];
+        }
+        const auto& row = g.adj[u];
+        for (int v = 0; v < V; v++) {
+            if (!done[v] && !IsInf(row[v]) && row[v] < key[v]) {
+                key[v] = row[v];
+                parent[v] = u;
+            }
+        }
+    }
+    return forest;
+}
+
+template SpanningForest Prim(const WeightedGraphView<float>&);
+template SpanningForest Prim(const WeightedGraphView<std::int32_t>&);
+template SpanningForest Prim(const WeightedGraphView<double>&);
+
+} // namespace alg
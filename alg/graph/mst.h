@@ -0,0 +1,80 @@
+#pragma once
+#include <vector>
+
+#include "alg/common/thread_pool.h"
+#include "edge.h"
+#include "graph.h"
+#include "weighted_csr.h"
+
+namespace alg {
+
+/**
+ * @brief Minimum spanning forest, one tree per connected component
+ */
+struct SpanningForest {
+    std::vector<Edge> edges;
+    double weight = 0;
+};
+
+/**
+ * @brief Kruskal over an undirected edge list
+ *
+ * Weights are mapped to order preserving 64-bit keys and sorted by a stable
+ * LSD radix sort whose histogram and scatter passes are split across the
+ * pool, passes where every key has the same byte are skipped. Equal weights
+ * keep the edge list order.
+ */
+SpanningForest Kruskal(int V, const std::vector<Edge>& edges, ThreadPool* pool = nullptr);
+
+/**
+ * @brief Boruvka rounds on a lock-free union-find
+ *
+ * Every round each component picks its lightest outgoing edge with an
+ * atomic min (ties broken by edge index, so the picks form a forest), the
+ * picks are merged in parallel and edges inside one component are dropped.
+ * Edges come out in Kruskal order.
+ */
+SpanningForest Boruvka(int V, const std::vector<Edge>& edges, ThreadPool* pool = nullptr);
+
+/**
+ * @brief Prim with an indexed 4-ary heap, restarted at every unvisited vertex
+ */
+template <typename W>
+SpanningForest Prim(const WeightedGraphView<W>& g);
+
+/**
+ * @brief Prim scanning the dense matrix, O(V^2) without a heap
+ */
+SpanningForest Prim(const WeightedGraph& g);
+
+inline SpanningForest Kruskal(const WeightedGraph& g, ThreadPool* pool = nullptr) {
+    return Kruskal(g.V, g.Edges(), pool);
+}
+inline SpanningForest Boruvka(const WeightedGraph& g, ThreadPool* pool = nullptr) {
+    return Boruvka(g.V, g.Edges(), pool);
+}
+
+template <typename W>
+SpanningForest Kruskal(const WeightedGraphView<W>& g, ThreadPool* pool = nullptr) {
+    return Kruskal(g.V, g.Edges(), pool);
+}
+template <typename W>
+SpanningForest Boruvka(const WeightedGraphView<W>& g, ThreadPool* pool = nullptr) {
+    return Boruvka(g.V, g.Edges(), pool);
+}
+
+// deduction does not see the implicit conversion to the view
+template <typename W>
+SpanningForest Prim(const WeightedCsrGraph<W>& g) {
+    return Prim(WeightedGraphView<W>(g));
+}
+template <typename W>
+SpanningForest Kruskal(const WeightedCsrGraph<W>& g, ThreadPool* pool = nullptr) {
+    return Kruskal(WeightedGraphView<W>(g), pool);
+}
+template <typename W>
+SpanningForest Boruvka(const WeightedCsrGraph<W>& g, ThreadPool* pool = nullptr) {
+    return Boruvka(WeightedGraphView<W>(g), pool);
+}
+
+} // namespace alg
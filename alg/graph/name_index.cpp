@@ -1,5 +1,139 @@
+#include <utility>
+
 #include "name_index.h"
 
 namespace alg {
 
+int NameTrie::Find(const char* name) const {
+    std::uint32_t l = root;
+    while (l != kNil) {
+        const Node& node = nodes[l];
+        char c = *name;
+        if (c < node.c) {
+            l = node.left;
+        }
+        else if (c > node.c) {
+            l = node.right;
+        }
+        else {
+            if (c == 0)
+                return node.index;
+            l = node.mid;
+            name++;
+        }
+    }
+    return -1;
+}
+
+void NameTrie::FindBatch(const char* const* names, std::size_t n, int* ids) const {
+    struct Lane {
+        const char* name;
+        std::size_t query;
+        std::uint32_t node;
+    };
+    Lane lanes[kLanes];
+    int active = 0;
+    std::size_t next = 0;
+
+    // start the next query in lane, false once all are started
+    auto start = [&](Lane& lane) {
+        if (next == n)
+            return false;
+        lane = Lane{names[next], next, root};
+        next++;
+        return true;
+    };
+    while (active < kLanes && start(lanes[active])) {
+        active++;
+    }
+
+    // an empty tree leaves every lane on the nil node, whose index is -1
+    while (active > 0) {
+        for (int k = 0; k < active; ) {
+            Lane& lane = lanes[k];
+            const Node& node = nodes[lane.node];
+            const char c = *lane.name;
+            std::uint32_t child = kNil;
+            int found = -1;
+            if (c < node.c)
+                child = node.left;
+            else if (c > node.c)
+                child = node.right;
+            else if (c == 0)
+                found = node.index;
+            else {
+                child = node.mid;
+                lane.name++;
+            }
+
+            if (child != kNil) {
+                lane.node = child;
+                __builtin_prefetch(&nodes[child]);
+                k++;
+                continue;
+            }
+            ids[lane.query] = found;
+            if (start(lane))
+                k++;
+            else
+                lane = lanes[--active];
+        }
+    }
+}
+
+int NameIndex::IndexByName(const char* name) {
+    if (root == kNil)
+        root = NewNode(*name);
+    std::uint32_t l = root;
+    while (true) {
+        // NewNode may move nodes, so no reference is held across it
+        char c = *name;
+        if (c < nodes[l].c) {
+            if (nodes[l].left == kNil) {
+                std::uint32_t k = NewNode(c);
+                nodes[l].left = k;
+            }
+            l = nodes[l].left;
+        }
+        else if (c > nodes[l].c) {
+            if (nodes[l].right == kNil) {
+                std::uint32_t k = NewNode(c);
+                nodes[l].right = k;
+            }
+            l = nodes[l].right;
+        }
+        else {
+            if (c == 0) {
+                if (nodes[l].index == -1)
+                    nodes[l].index = N++;
+                return nodes[l].index;
+            }
+            name++;
+            if (nodes[l].mid == kNil) {
+                std::uint32_t k = NewNode(*name);
+                nodes[l].mid = k;
+            }
+            l = nodes[l].mid;
+        }
+    }
+}
+
+NameIndexSnapshot NameIndex::Snapshot() const {
+    NameIndexSnapshot snapshot;
+    snapshot.nodes = nodes;
+    snapshot.root = root;
+    snapshot.N = N;
+    return snapshot;
+}
+
+NameIndexSnapshot NameIndex::Freeze() {
+    NameIndexSnapshot snapshot;
+    snapshot.nodes = std::move(nodes);
+    snapshot.nodes.shrink_to_fit();
+    snapshot.root = root;
+    snapshot.N = N;
+    *this = NameIndex();
+    return snapshot;
+}
+
 } // namespace alg
@@ -1,64 +1,98 @@
 #pragma once
-#include <cstdlib>
-#include "alg/tree/node.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
 
 namespace alg {
 
-class NameIndex {
+/**
+ * @brief Read side of a ternary search tree kept in one node arena
+ *
+ * Children are 32-bit indices into nodes, 0 is the nil node, so the tree
+ * is freed, copied and moved as a single vector and a lookup is a loop
+ * over array slots.
+ */
+class NameTrie {
 public:
-    struct IdxChar {
-        int index;
-        char c;
-    };
-    using Node = Tnode3<IdxChar>;
-    using Link = Node*;
+    /**
+     * @brief Index of name, -1 if it was never added
+     */
+    int Find(const char* name) const;
 
-    ~NameIndex() {
-        DeleteTree(root);
-    }
-
-    int IndexByName(const char* name) {
-        int index;
-        root = IndexR(root, name, 0, index);
-        return index;
-    }
+    /**
+     * @brief ids[i] = Find(names[i]), with kLanes lookups in flight
+     *
+     * Each round advances every lane by one node and prefetches the next,
+     * so the cache misses of independent lookups overlap.
+     */
+    void FindBatch(const char* const* names, std::size_t n, int* ids) const;
 
     int Count() const {
         return N;
     }
 
+protected:
+    static constexpr std::uint32_t kNil = 0;
+    static constexpr int kLanes = 16;
+
+    struct Node {
+        std::uint32_t left, mid, right;
+        int index;
+        char c;
+    };
+
+protected:
+    std::vector<Node> nodes = std::vector<Node>(1, Node{kNil, kNil, kNil, -1, 0});
+    std::uint32_t root = kNil;
+    int N = 0;
+};
+
+/**
+ * @brief Frozen copy of a NameIndex for lookups only, move-only
+ */
+class NameIndexSnapshot : public NameTrie {
+public:
+    NameIndexSnapshot() = default;
+    NameIndexSnapshot(NameIndexSnapshot&&) = default;
+    NameIndexSnapshot& operator=(NameIndexSnapshot&&) = default;
+    NameIndexSnapshot(const NameIndexSnapshot&) = delete;
+    NameIndexSnapshot& operator=(const NameIndexSnapshot&) = delete;
+
 private:
-    Link IndexR(Link l, const char* name, std::size_t i, int& index) {
-        char c = name[i];
-        if (!l) {
-            l = NewNode(c);
-        }
-        if (c == 0) {
-            if (l->value.index == -1)
-                l->value.index = N++;
-            index = l->value.index;
-            return l;
-        }
-        if (c < l->value.c)
-            l->left = IndexR(l->left, name, i, index);
-        else if (c == l->value.c)
-            l->mid = IndexR(l->mid, name, i + 1, index);
-        else
-            l->right = IndexR(l->right, name, i, index);
-        return l;
-    }
+    friend class NameIndex;
+};
 
-    Link NewNode(char c) {
-        Link l = new Node();
-        l->value.c = c;
-        l->value.index = -1;
-        l->left = l->mid = l->right = nullptr;
-        return l;
-    }
+/**
+ * @brief Dense ids for names in order of first appearance
+ */
+class NameIndex : public NameTrie {
+public:
+    NameIndex() = default;
+    NameIndex(NameIndex&&) = default;
+    NameIndex& operator=(NameIndex&&) = default;
+    NameIndex(const NameIndex&) = delete;
+    NameIndex& operator=(const NameIndex&) = delete;
+
+    /**
+     * @brief Index of name, added as Count() if new
+     */
+    int IndexByName(const char* name);
+
+    /**
+     * @brief Copy of the current names, unaffected by later inserts
+     */
+    NameIndexSnapshot Snapshot() const;
+
+    /**
+     * @brief Move the tree into a snapshot, leaving this index empty
+     */
+    NameIndexSnapshot Freeze();
 
 private:
-    int N = 0;
-    Link root = nullptr;
+    std::uint32_t NewNode(char c) {
+        nodes.push_back(Node{kNil, kNil, kNil, -1, c});
+        return static_cast<std::uint32_t>(nodes.size() - 1);
+    }
 };
 
 } // namespace alg
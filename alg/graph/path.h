@@ -2,9 +2,14 @@
 #include <unordered_map>
 #include <stack>
 #include <algorithm>
+#include <memory>
 
 #include "alg/common/common.h"
 #include "graph.h"
+#include "csr.h"
+#include "bcc.h"
+#include "euler.h"
+#include "hamilton.h"
 #include "search.h"
 
 namespace alg {
@@ -14,10 +19,33 @@ void PrintPath(const std::vector<LinkEdge>& path);
 void PrintBridges(const std::vector<Edge>& bridges);
 void PrintSeparations(const std::vector<int>& separations);
 
+/**
+ * @brief Path and DFS queries over a read-only CSR view
+ *
+ * Views and CsrGraph lvalues are not copied and must outlive the Path. A
+ * dense Graph is converted once and a CsrGraph rvalue is moved in; copies
+ * of the Path share that graph.
+ */
 class Path {
 public:
-    Path(const Graph& g)
-        : graph(g) {}
+    Path(const Graph& graph)
+        : owned(std::make_shared<const CsrGraph>(graph)),
+          g(*owned) {
+        frames.reserve(g.V);
+    }
+    Path(CsrGraph&& graph)
+        : owned(std::make_shared<const CsrGraph>(std::move(graph))),
+          g(*owned) {
+        frames.reserve(g.V);
+    }
+    Path(const CsrGraph& graph)
+        : g(graph) {
+        frames.reserve(g.V);
+    }
+    Path(const GraphView& graph)
+        : g(graph) {
+        frames.reserve(g.V);
+    }
 
     /**
      * @brief Path from u to v
@@ -28,7 +56,7 @@ public:
             return true;
         }
         visited[u] = true;
-        for (int i : graph.Adj(u)) {
+        for (int i : g.Adj(u)) {
             if (!visited[i]) {
                 if (PathDsfR(i, v, visited, path)) {
                     path.push_back(u);
@@ -38,13 +66,38 @@ public:
         }
         return false;
     }
+    bool PathDsfI(int u, int v, std::vector<int>& path) {
+        if (u == v) {
+            path.push_back(v);
+            return true;
+        }
+        std::vector<bool> visited(g.V, false);
+        frames.clear();
+        visited[u] = true;
+        frames.push_back(Frame(u, u, g.offsets[u]));
+        while (!frames.empty()) {
+            Frame& f = frames.back();
+            if (f.next == g.offsets[f.v + 1]) {
+                frames.pop_back();
+                continue;
+            }
+            int i = g.neighbors[f.next++];
+            if (visited[i])
+                continue;
+            if (i == v) {
+                for (const auto& frame : frames) {
+                    path.push_back(frame.v);
+                }
+                path.push_back(v);
+                return true;
+            }
+            visited[i] = true;
+            frames.push_back(Frame(f.v, i, g.offsets[i]));
+        }
+        return false;
+    }
     bool PathDsf(int u, int v, std::vector<int>& path) {
-        std::unordered_map<int, bool> visited;
-        bool res = PathDsfR(u, v, visited, path);
-
-        std::reverse(path.begin(), path.end());
-
-        return res;
+        return PathDsfI(u, v, path);
     }
 
     /**
@@ -61,7 +114,7 @@ public:
             }
         }
         visited[u] = true;
-        for (int i : graph.Adj(u)) {
+        for (int i : g.Adj(u)) {
             if (!visited[i]) {
                 if (PathHamiltonR(i, v, depth - 1, visited, path)) {
                     path.push_back(u);
@@ -72,59 +125,28 @@ public:
         visited[u] = false;
         return false;
     }
-    bool PathHamilton(int u, int v, std::vector<int>& path) {
-        std::unordered_map<int, bool> visited;
-
-        bool res = PathHamiltonR(u, v, graph.V - 1, visited, path);
-
-        std::reverse(path.begin(), path.end());
-        return res;
+    bool PathHamilton(int u, int v, std::vector<int>& path, ThreadPool* pool = nullptr) const {
+        return Hamilton(g).Path(u, v, path, pool);
     }
 
     /**
      * @brief Euler path
      */
-    bool PathEulerExist(int u, int v) {
-        if ((graph.Deg(u) + graph.Deg(v)) % 2 != 0)
-            return false;
-        for (int i = 0; i < graph.V; i++) {
-            if (i != u && i != v) {
-                if ((graph.Deg(i) % 2) != 0)
-                    return false;
-            }
-        }
-        return true;
+    bool PathEulerExist(int u, int v) const {
+        return Euler(g).Exist(u, v);
     }
-    int PathEulerR(Graph& g, int u, std::stack<int>& st) {
-        while (!g.Adj(u).empty()) {
-            st.push(u);
-            int v = g.Adj(u)[0];
-            g.RemoveEdge(u, v);
-            u = v;
-        }
-        return u;
+    bool PathEuler(int u, int v, std::vector<int>& path) const {
+        return Euler(g).Path(u, v, path);
     }
-    bool PathEuler(int u, int v, std::vector<int>& path) {
-        if (!PathEulerExist(u, v))
-            return false;
-
-        path.push_back(v);
-        std::stack<int> st;
-        Graph g = graph;
-        while (PathEulerR(g, u, st) == u && !st.empty()) {
-            u = STpop(st);
-            path.push_back(u);
-        }
-
-        std::reverse(path.begin(), path.end());
-        return true;
+    bool CircuitEuler(int u, std::vector<int>& path) const {
+        return Euler(g).Circuit(u, path);
     }
 
     /**
      * @brief Dfs
      */
     void DfsR(int u, int& pre, DFS& dfs) {
-        for (int i : graph.Adj(u)) {
+        for (int i : g.Adj(u)) {
             if (dfs.pre[i] == -1) {
                 dfs.st[i] = u;
                 dfs.pre[i] = pre++;
@@ -132,11 +154,28 @@ public:
             }
         }
     }
+    void DfsI(int u, int& pre, DFS& dfs) {
+        frames.clear();
+        frames.push_back(Frame(u, u, g.offsets[u]));
+        while (!frames.empty()) {
+            Frame& f = frames.back();
+            if (f.next == g.offsets[f.v + 1]) {
+                frames.pop_back();
+                continue;
+            }
+            int i = g.neighbors[f.next++];
+            if (dfs.pre[i] == -1) {
+                dfs.st[i] = f.v;
+                dfs.pre[i] = pre++;
+                frames.push_back(Frame(f.v, i, g.offsets[i]));
+            }
+        }
+    }
     void Dfs(DFS& dfs, int u) {
         int pre = 0;
         dfs.st[u] = u;
         dfs.pre[u] = pre++;
-        DfsR(u, pre, dfs);
+        DfsI(u, pre, dfs);
     }
 
     /**
@@ -144,17 +183,34 @@ public:
      */
     void DfsCCR(DFS& dfs, int u, int id) {
         dfs.cc[u] = id;
-        for (int i : graph.Adj(u)) {
+        for (int i : g.Adj(u)) {
             if (dfs.cc[i] == -1) {
                 DfsCCR(dfs, i, id);
             }
         }
     }
+    void DfsCCI(DFS& dfs, int u, int id) {
+        frames.clear();
+        dfs.cc[u] = id;
+        frames.push_back(Frame(u, u, g.offsets[u]));
+        while (!frames.empty()) {
+            Frame& f = frames.back();
+            if (f.next == g.offsets[f.v + 1]) {
+                frames.pop_back();
+                continue;
+            }
+            int i = g.neighbors[f.next++];
+            if (dfs.cc[i] == -1) {
+                dfs.cc[i] = id;
+                frames.push_back(Frame(f.v, i, g.offsets[i]));
+            }
+        }
+    }
     void DfsCC(DFS& dfs) {
         int id = 0;
-        for (int u = 0; u < graph.V; u++) {
+        for (int u = 0; u < g.V; u++) {
             if (dfs.cc[u] == -1) {
-                DfsCCR(dfs, u, id++);
+                DfsCCI(dfs, u, id++);
             }
         }
     }
@@ -171,7 +227,7 @@ public:
      */
     void DfsEulerR(DFS& dfs, const Edge& e, int& pre, std::vector<LinkEdge>& edges) {
         dfs.pre[e.v] = pre++;
-        for (int i : graph.Adj(e.v)) {
+        for (int i : g.Adj(e.v)) {
             if (dfs.pre[i] == -1) {
                 edges.push_back(LinkEdge(Edge(e.v, i), kTreeLink));
                 DfsEulerR(dfs, Edge(e.v, i), pre, edges);
@@ -183,11 +239,34 @@ public:
         }
         edges.push_back(LinkEdge(Edge(e.v, e.u), kParentLink));
     }
+    void DfsEulerI(DFS& dfs, const Edge& e, int& pre, std::vector<LinkEdge>& edges) {
+        frames.clear();
+        dfs.pre[e.v] = pre++;
+        frames.push_back(Frame(e.u, e.v, g.offsets[e.v]));
+        while (!frames.empty()) {
+            Frame& f = frames.back();
+            if (f.next == g.offsets[f.v + 1]) {
+                edges.push_back(LinkEdge(Edge(f.v, f.u), kParentLink));
+                frames.pop_back();
+                continue;
+            }
+            int i = g.neighbors[f.next++];
+            if (dfs.pre[i] == -1) {
+                edges.push_back(LinkEdge(Edge(f.v, i), kTreeLink));
+                dfs.pre[i] = pre++;
+                frames.push_back(Frame(f.v, i, g.offsets[i]));
+            }
+            else if (dfs.pre[i] < dfs.pre[f.u]) {
+                edges.push_back(LinkEdge(Edge(f.v, i), kBackLink));
+                edges.push_back(LinkEdge(Edge(i, f.v), kBackLink));
+            }
+        }
+    }
     void DfsEuler(DFS& dfs, const Edge& e, std::vector<LinkEdge>& edges) {
         int pre = 0;
         dfs.pre[e.u] = pre++;
         edges.push_back(LinkEdge(Edge(e.u, e.v), kTreeLink));
-        DfsEulerR(dfs, e, pre, edges);
+        DfsEulerI(dfs, e, pre, edges);
     }
 
     /**
@@ -196,7 +275,7 @@ public:
     bool DfsBipartiteR(DFS& dfs, int u, int& pre, int c) {
         dfs.pre[u] = pre++;
         dfs.color2[u] = c;
-        for (int i : graph.Adj(u)) {
+        for (int i : g.Adj(u)) {
             if (dfs.color2[i] == -1) {
                 if (!DfsBipartiteR(dfs, i, pre, 1 - c)) {
                     return false;
@@ -208,11 +287,35 @@ public:
         }
         return true;
     }
+    bool DfsBipartiteI(DFS& dfs, int u, int& pre, int c) {
+        frames.clear();
+        dfs.pre[u] = pre++;
+        dfs.color2[u] = c;
+        frames.push_back(Frame(u, u, g.offsets[u]));
+        while (!frames.empty()) {
+            Frame& f = frames.back();
+            if (f.next == g.offsets[f.v + 1]) {
+                frames.pop_back();
+                continue;
+            }
+            int i = g.neighbors[f.next++];
+            c = dfs.color2[f.v];
+            if (dfs.color2[i] == -1) {
+                dfs.pre[i] = pre++;
+                dfs.color2[i] = 1 - c;
+                frames.push_back(Frame(f.v, i, g.offsets[i]));
+            }
+            else if (dfs.color2[i] == c) {
+                return false;
+            }
+        }
+        return true;
+    }
     bool DfsBipartite(DFS& dfs) {
         int pre = 0;
-        for (int u = 0; u < graph.V; u++) {
+        for (int u = 0; u < g.V; u++) {
             if (dfs.color2[u] == -1) {
-                if (!DfsBipartiteR(dfs, u, pre, 0))
+                if (!DfsBipartiteI(dfs, u, pre, 0))
                     return false;
             }
         }
@@ -225,7 +328,7 @@ public:
     void DfsBridgesR(DFS& dfs, const Edge& e, int& pre, std::vector<Edge>& bridges) {
         dfs.pre[e.v] = pre++;
         dfs.low[e.v] = dfs.pre[e.v];
-        for (int i : graph.Adj(e.v)) {
+        for (int i : g.Adj(e.v)) {
             if (dfs.pre[i] == -1) {
                 DfsBridgesR(dfs, Edge(e.v, i), pre, bridges);
                 if (dfs.low[i] < dfs.low[e.v])
@@ -240,42 +343,78 @@ public:
             }
         }
     }
+    void DfsBridgesI(DFS& dfs, const Edge& e, int& pre, std::vector<Edge>& bridges) {
+        frames.clear();
+        dfs.pre[e.v] = pre++;
+        dfs.low[e.v] = dfs.pre[e.v];
+        frames.push_back(Frame(e.u, e.v, g.offsets[e.v]));
+        while (!frames.empty()) {
+            Frame& f = frames.back();
+            if (f.next == g.offsets[f.v + 1]) {
+                int i = f.v;
+                frames.pop_back();
+                if (frames.empty())
+                    break;
+                // back in the parent after the tree edge (v, i)
+                int v = frames.back().v;
+                if (dfs.low[i] < dfs.low[v])
+                    dfs.low[v] = dfs.low[i];
+
+                if (dfs.pre[i] == dfs.low[i])
+                    bridges.push_back(Edge(v, i));
+                continue;
+            }
+            int i = g.neighbors[f.next++];
+            if (dfs.pre[i] == -1) {
+                dfs.pre[i] = pre++;
+                dfs.low[i] = dfs.pre[i];
+                frames.push_back(Frame(f.v, i, g.offsets[i]));
+            }
+            else if (i != f.u) {
+                if (dfs.low[i] < dfs.low[f.v])
+                    dfs.low[f.v] = dfs.low[i];
+            }
+        }
+    }
     void DfsBridges(DFS& dfs, const Edge& e, std::vector<Edge>& bridges) {
         int pre = 0;
-        DfsBridgesR(dfs, e, pre, bridges);
+        DfsBridgesI(dfs, e, pre, bridges);
     }
 
     /**
-     * @brief Separation vertices
+     * @brief Bridges of every connected component
      */
-//    void DfsSeparationVerticesR(DFS& dfs, const Edge& e, int& pre, std::vector<int>& separations) {
-//        dfs.pre[e.v] = pre++;
-//        dfs.low[e.v] = dfs.pre[e.v];
-//        bool is_separation = true;
-//        for (int i : graph.Adj(e.v)) {
-//            if (dfs.pre[i] == -1) {
-//                DfsSeparationVerticesR(dfs, Edge(e.v, i), pre, separations);
-//                if (dfs.low[i] < dfs.low[e.v])
-//                    dfs.low[e.v] = dfs.low[i];
-//            }
-//            else if (i != e.u) {
-//                if (dfs.low[i] < dfs.low[e.v])
-//                    dfs.low[e.v] = dfs.low[i];
-//            }
+    void DfsBridges(DFS& dfs, std::vector<Edge>& bridges) const {
+        BCC bcc(g);
+        bcc.Run(dfs);
+        bridges = std::move(bcc.bridges);
+    }
 
-//            if ((dfs.pre[i] - dfs.pre[e.v]) * (dfs.low[i] - dfs.low[e.v]) < 0)
-//                is_separation = false;
-//        }
-//        if (is_separation)
-//            separations.push_back(e.v);
-//    }
-//    void DfsSeparationVertices(DFS& dfs, const Edge& e, std::vector<int>& separations) {
-//        int pre = 0;
-//        DfsSeparationVerticesR(dfs, e, pre, separations);
-//    }
+    /**
+     * @brief Separation vertices
+     */
+    void DfsSeparationVertices(DFS& dfs, std::vector<int>& separations) const {
+        BCC bcc(g);
+        bcc.Run(dfs);
+        separations = std::move(bcc.separations);
+    }
 
 private:
-    Graph graph;
+    /**
+     * @brief Explicit stack frame: vertex v entered from u, next neighbor slot
+     */
+    struct Frame {
+        Frame(int u_, int v_, std::int64_t next_)
+            : u(u_), v(v_), next(next_) {}
+
+        int u, v;
+        std::int64_t next;
+    };
+
+    std::shared_ptr<const CsrGraph> owned;
+    GraphView g;
+    // stack of the iterative searches, sized once like the queue of BFS
+    std::vector<Frame> frames;
 };
 
 } // namespace alg
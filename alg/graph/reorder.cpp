@@ -0,0 +1,182 @@
+#include <numeric>
+
+#include "reorder.h"
+
+namespace alg {
+namespace {
+constexpr std::int64_t kGrain = 256;
+
+// breadth-first search from root over unmarked vertices, appending them to
+// order; neighbors by increasing degree if by_degree
+void Visit(const GraphView& g, int root, bool by_degree, std::vector<char>& marked, std::vector<int>& order) {
+    std::size_t head = order.size();
+    marked[root] = 1;
+    order.push_back(root);
+    while (head < order.size()) {
+        const int u = order[head++];
+        const std::size_t first = order.size();
+        for (int v : g.Adj(u)) {
+            if (!marked[v]) {
+                marked[v] = 1;
+                order.push_back(v);
+            }
+        }
+        if (by_degree) {
+            std::stable_sort(order.begin() + first, order.end(), [&](int a, int b) {
+                return g.Deg(a) < g.Deg(b);
+            });
+        }
+    }
+}
+
+// George-Liu: restart from a smallest-degree vertex of the last level while
+// the eccentricity grows
+int PseudoPeripheral(const GraphView& g, int start, std::vector<int>& stamp, int& clock,
+                     std::vector<int>& queue, std::vector<int>& depth) {
+    int root = start;
+    int eccentricity = -1;
+    for (int round = 0; round < 8; round++) {
+        clock++;
+        queue.assign(1, root);
+        depth[root] = 0;
+        stamp[root] = clock;
+        for (std::size_t head = 0; head < queue.size(); head++) {
+            const int u = queue[head];
+            for (int v : g.Adj(u)) {
+                if (stamp[v] != clock) {
+                    stamp[v] = clock;
+                    depth[v] = depth[u] + 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+        const int far = depth[queue.back()];
+        if (far <= eccentricity)
+            break;
+        eccentricity = far;
+        int next = queue.back();
+        for (auto it = queue.rbegin(); it != queue.rend() && depth[*it] == far; ++it) {
+            if (g.Deg(*it) < g.Deg(next))
+                next = *it;
+        }
+        root = next;
+    }
+    return root;
+}
+} // namespace
+
+Permutation::Permutation(const std::vector<int>& order)
+    : new_id(order.size()),
+      old_id(order) {
+    for (std::size_t k = 0; k < order.size(); k++) {
+        new_id[order[k]] = static_cast<int>(k);
+    }
+}
+
+std::vector<int> Permutation::ApplyIds(const std::vector<int>& ids) const {
+    std::vector<int> result(ids.size());
+    for (std::size_t v = 0; v < ids.size(); v++) {
+        result[new_id[v]] = ids[v] == -1 ? -1 : new_id[ids[v]];
+    }
+    return result;
+}
+
+std::vector<int> Permutation::RestoreIds(const std::vector<int>& ids) const {
+    std::vector<int> result(ids.size());
+    for (std::size_t v = 0; v < ids.size(); v++) {
+        result[old_id[v]] = ids[v] == -1 ? -1 : old_id[ids[v]];
+    }
+    return result;
+}
+
+Permutation DegreeOrder(const GraphView& g) {
+    // counting sort by degree, descending and stable
+    int max_deg = 0;
+    for (int u = 0; u < g.V; u++) {
+        max_deg = std::max(max_deg, g.Deg(u));
+    }
+    std::vector<int> start(max_deg + 2, 0);
+    for (int u = 0; u < g.V; u++) {
+        start[max_deg - g.Deg(u) + 1]++;
+    }
+    std::partial_sum(start.begin(), start.end(), start.begin());
+    std::vector<int> order(g.V);
+    for (int u = 0; u < g.V; u++) {
+        order[start[max_deg - g.Deg(u)]++] = u;
+    }
+    return Permutation(order);
+}
+
+Permutation HubSortOrder(const GraphView& g) {
+    const double mean = g.V ? static_cast<double>(g.offsets[g.V]) / g.V : 0;
+    std::vector<int> order;
+    order.reserve(g.V);
+    for (int u = 0; u < g.V; u++) {
+        if (g.Deg(u) > mean)
+            order.push_back(u);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return g.Deg(a) > g.Deg(b);
+    });
+    for (int u = 0; u < g.V; u++) {
+        if (g.Deg(u) <= mean)
+            order.push_back(u);
+    }
+    return Permutation(order);
+}
+
+Permutation BfsOrder(const GraphView& g, int source) {
+    std::vector<char> marked(g.V, 0);
+    std::vector<int> order;
+    order.reserve(g.V);
+    if (source >= 0)
+        Visit(g, source, false, marked, order);
+    for (int u = 0; u < g.V; u++) {
+        if (!marked[u])
+            Visit(g, u, false, marked, order);
+    }
+    return Permutation(order);
+}
+
+Permutation RcmOrder(const GraphView& g) {
+    std::vector<char> marked(g.V, 0);
+    std::vector<int> stamp(g.V, 0), depth(g.V, 0), queue;
+    int clock = 0;
+    std::vector<int> order;
+    order.reserve(g.V);
+    for (int u = 0; u < g.V; u++) {
+        if (!marked[u])
+            Visit(g, PseudoPeripheral(g, u, stamp, clock, queue, depth), true, marked, order);
+    }
+    std::reverse(order.begin(), order.end());
+    return Permutation(order);
+}
+
+CsrGraph Relabel(const GraphView& g, const Permutation& p, ThreadPool* pool) {
+    CsrGraph r;
+    r.V = g.V;
+    r.E = g.E;
+    r.directed = g.directed;
+    r.offsets.assign(g.V + 1, 0);
+    for (int v = 0; v < g.V; v++) {
+        r.offsets[v + 1] = r.offsets[v] + g.Deg(p.old_id[v]);
+    }
+    r.neighbors.resize(r.offsets[g.V]);
+
+    auto body = [&](std::int64_t begin, std::int64_t end, int) {
+        for (std::int64_t v = begin; v < end; v++) {
+            std::int64_t k = r.offsets[v];
+            for (int w : g.Adj(p.old_id[v])) {
+                r.neighbors[k++] = p.new_id[w];
+            }
+            std::sort(r.neighbors.begin() + r.offsets[v], r.neighbors.begin() + k);
+        }
+    };
+    if (pool)
+        pool->ParallelFor(g.V, kGrain, body);
+    else if (g.V > 0)
+        body(0, g.V, 0);
+    return r;
+}
+
+} // namespace alg
@@ -0,0 +1,130 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+
+#include "alg/common/thread_pool.h"
+#include "csr.h"
+#include "weighted_csr.h"
+
+namespace alg {
+
+/**
+ * @brief Vertex relabeling, new_id[old] and its inverse old_id[new]
+ *
+ * Graphs are relabeled once, traversals run on the relabeled copy, and
+ * their per-vertex results are mapped back to the original ids with
+ * Restore, or RestoreIds for arrays that hold vertex ids such as DFS::st.
+ */
+class Permutation {
+public:
+    Permutation() = default;
+
+    /**
+     * @brief From a visiting order, order[new] = old
+     */
+    explicit Permutation(const std::vector<int>& order);
+
+    int Size() const {
+        return static_cast<int>(new_id.size());
+    }
+
+    /**
+     * @brief result[new_id[v]] = values[v]
+     */
+    template <typename T>
+    std::vector<T> Apply(const std::vector<T>& values) const {
+        std::vector<T> result(values.size());
+        for (std::size_t v = 0; v < values.size(); v++) {
+            result[new_id[v]] = values[v];
+        }
+        return result;
+    }
+
+    /**
+     * @brief result[old_id[v]] = values[v], undoes Apply
+     */
+    template <typename T>
+    std::vector<T> Restore(const std::vector<T>& values) const {
+        std::vector<T> result(values.size());
+        for (std::size_t v = 0; v < values.size(); v++) {
+            result[old_id[v]] = values[v];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Apply to an array of vertex ids, mapping the ids too; -1 stays
+     */
+    std::vector<int> ApplyIds(const std::vector<int>& ids) const;
+    std::vector<int> RestoreIds(const std::vector<int>& ids) const;
+
+public:
+    std::vector<int> new_id;
+    std::vector<int> old_id;
+};
+
+/**
+ * @brief Decreasing degree, ties by id
+ */
+Permutation DegreeOrder(const GraphView& g);
+
+/**
+ * @brief Hub sorting: vertices above the mean degree first, by decreasing
+ *        degree; the others keep their relative order
+ *
+ * Packs the hot rows together while leaving most of the input's own
+ * locality intact.
+ */
+Permutation HubSortOrder(const GraphView& g);
+
+/**
+ * @brief Breadth-first visiting order, each component from its smallest
+ *        vertex, source's component first if given
+ */
+Permutation BfsOrder(const GraphView& g, int source = -1);
+
+/**
+ * @brief Reverse Cuthill-McKee
+ *
+ * Every component is searched breadth first from a pseudo-peripheral
+ * vertex, neighbors in increasing degree order, and the whole order is
+ * reversed. Keeps the labels of adjacent vertices close, i.e. a small
+ * matrix bandwidth.
+ */
+Permutation RcmOrder(const GraphView& g);
+
+/**
+ * @brief Copy of g with vertex v renamed to p.new_id[v], rows sorted
+ */
+CsrGraph Relabel(const GraphView& g, const Permutation& p, ThreadPool* pool = nullptr);
+
+template <typename W>
+WeightedCsrGraph<W> Relabel(const WeightedGraphView<W>& g, const Permutation& p, ThreadPool* pool = nullptr) {
+    WeightedCsrGraph<W> r;
+    const CsrGraph topology = Relabel(static_cast<const GraphView&>(g), p, pool);
+    r.V = topology.V;
+    r.E = topology.E;
+    r.directed = topology.directed;
+    r.offsets = topology.offsets;
+    r.targets = topology.neighbors;
+    r.weights.resize(r.targets.size());
+
+    // rows are distinct targets, so each weight lands by binary search
+    auto body = [&](std::int64_t begin, std::int64_t end, int) {
+        for (std::int64_t u = begin; u < end; u++) {
+            const std::int64_t first = r.offsets[p.new_id[u]];
+            const std::int64_t last = r.offsets[p.new_id[u] + 1];
+            for (const auto& a : g.Edges(static_cast<int>(u))) {
+                auto it = std::lower_bound(r.targets.begin() + first, r.targets.begin() + last, p.new_id[a.v]);
+                r.weights[it - r.targets.begin()] = a.w;
+            }
+        }
+    };
+    if (pool)
+        pool->ParallelFor(g.V, 256, body);
+    else if (g.V > 0)
+        body(0, g.V, 0);
+    return r;
+}
+
+} // namespace alg
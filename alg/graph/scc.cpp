@@ -0,0 +1,79 @@
+#include "scc.h"
+
+namespace alg {
+
+void SCC::Run() {
+    const int V = g.V;
+    std::vector<int> pre(V, -1), low(V, -1);
+    Bitmap on_stack(V);
+    std::vector<int> st;
+    std::vector<Frame> frames;
+    frames.reserve(V);
+    id.assign(V, -1);
+
+    // Tarjan emits sinks first, ids are flipped at the end
+    int found = 0;
+    int n = 0;
+    for (int root = 0; root < V; root++) {
+        if (pre[root] != -1)
+            continue;
+
+        pre[root] = low[root] = n++;
+        st.push_back(root);
+        on_stack.Set(root);
+        frames.push_back(Frame(root, g.offsets[root]));
+        while (!frames.empty()) {
+            Frame& f = frames.back();
+            int v = f.v;
+            if (f.next < g.offsets[v + 1]) {
+                int w = g.neighbors[f.next++];
+                if (pre[w] == -1) {
+                    pre[w] = low[w] = n++;
+                    st.push_back(w);
+                    on_stack.Set(w);
+                    frames.push_back(Frame(w, g.offsets[w]));
+                }
+                else if (on_stack.Test(w) && pre[w] < low[v]) {
+                    low[v] = pre[w];
+                }
+                continue;
+            }
+
+            frames.pop_back();
+            if (low[v] == pre[v]) {
+                while (true) {
+                    int w = st.back();
+                    st.pop_back();
+                    on_stack.Clear(w);
+                    id[w] = found;
+                    if (w == v)
+                        break;
+                }
+                found++;
+            }
+            if (!frames.empty()) {
+                int p = frames.back().v;
+                if (low[v] < low[p])
+                    low[p] = low[v];
+            }
+        }
+    }
+
+    count = found;
+    for (int u = 0; u < V; u++) {
+        id[u] = count - 1 - id[u];
+    }
+}
+
+CsrGraph SCC::Condensation() const {
+    std::vector<Edge> edges;
+    for (int u = 0; u < g.V; u++) {
+        for (int v : g.Adj(u)) {
+            if (id[u] != id[v])
+                edges.push_back(Edge(id[u], id[v]));
+        }
+    }
+    return CsrGraph(count, edges, true);
+}
+
+} // namespace alg
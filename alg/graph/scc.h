@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "alg/common/bitmap.h"
+#include "csr.h"
+
+namespace alg {
+
+/**
+ * @brief Strongly connected components of a directed graph
+ *
+ * Iterative Tarjan. Components are numbered in topological order of the
+ * condensation, so every edge between two components goes from a smaller
+ * id to a larger one. The graph must outlive the engine.
+ */
+class SCC {
+public:
+    explicit SCC(const GraphView& graph)
+        : g(graph) {}
+
+    void Run();
+
+    int Count() const {
+        return count;
+    }
+
+    bool StronglyConnected(int u, int v) const {
+        return id[u] == id[v];
+    }
+
+    /**
+     * @brief DAG with one vertex per component and no repeated edges
+     */
+    CsrGraph Condensation() const;
+
+public:
+    // component of every vertex
+    std::vector<int> id;
+
+private:
+    struct Frame {
+        Frame(int v_, std::int64_t next_)
+            : v(v_), next(next_) {}
+
+        int v;
+        std::int64_t next;
+    };
+
+private:
+    GraphView g;
+    int count = 0;
+};
+
+} // namespace alg
@@ -1,5 +1,255 @@
+#include <string>
+
 #include "search.h"
 
 namespace alg {
+namespace {
+constexpr std::int64_t kTopDownGrain = 64;
+// multiple of 64 so that no two chunks share a bitmap word
+constexpr std::int64_t kBottomUpGrain = 64 * 64;
+} // namespace
+
+DfsTreeLayout::DfsTreeLayout(const std::vector<int>& st)
+    : V(static_cast<int>(st.size())),
+      offsets(V + 1, 0),
+      ws(V, 0),
+      ds(V, 0) {
+    for (int i = 0; i < V; i++) {
+        if (st[i] == i)
+            roots.push_back(i);
+        else if (st[i] != -1)
+            offsets[st[i] + 1]++;
+    }
+    for (int u = 0; u < V; u++) {
+        offsets[u + 1] += offsets[u];
+    }
+    children.resize(offsets[V]);
+    std::vector<int> next(offsets.begin(), offsets.end() - 1);
+    for (int i = 0; i < V; i++) {
+        if (st[i] != -1 && st[i] != i)
+            children[next[st[i]]++] = i;
+    }
+
+    // the k-th child sits one column right of its parent and k rows down
+    std::vector<int> queue(roots);
+    for (std::size_t head = 0; head < queue.size(); head++) {
+        const int u = queue[head];
+        for (int k = offsets[u]; k < offsets[u + 1]; k++) {
+            const int v = children[k];
+            ws[v] = ws[u] + 1;
+            ds[v] = ds[u] + (k - offsets[u]);
+            queue.push_back(v);
+        }
+    }
+}
+
+void DfsTreeLayout::Write(std::ostream& os, int root) const {
+    int node_width = 0;
+    for (int n = V; n; n /= 10) {
+        node_width++;
+    }
+
+    // preorder, a vertex on another row than the last starts a new branch
+    int cur_depth = 0;
+    std::vector<int> stack = {root};
+    while (!stack.empty()) {
+        const int u = stack.back();
+        stack.pop_back();
+        if (ds[u] != cur_depth) {
+            const int prefix_size = ws[u] * (node_width + 1);
+            os << '\n' << std::string(prefix_size - 1, ' ') << "|\n" << std::string(prefix_size, ' ');
+            cur_depth = ds[u];
+        }
+        os << "-" << std::setw(node_width) << std::right << u;
+        for (int k = offsets[u + 1] - 1; k >= offsets[u]; k--) {
+            stack.push_back(children[k]);
+        }
+    }
+    os << '\n';
+}
+
+void DfsTreeLayout::WriteAll(std::ostream& os) const {
+    for (int root : roots) {
+        Write(os, root);
+    }
+}
+
+void BFS::Reset() {
+    for (std::int64_t i = 0; i < visited_count; i++) {
+        st[queue[i]] = -1;
+        dist[queue[i]] = -1;
+    }
+    visited_count = 0;
+    levels = 0;
+    bottom_up_levels = 0;
+}
+
+void BFS::Run(const GraphView& g, int source, ThreadPool* pool) {
+    Reset();
+    bool parallel = pool && pool->Size() > 1;
+    if (parallel) {
+        if (visited.Size() != static_cast<std::size_t>(V)) {
+            visited.Resize(V);
+            front_atomic.Resize(V);
+        }
+        else {
+            visited.Reset();
+        }
+        locals.resize(pool->Size());
+        visited.Set(source);
+    }
+
+    st[source] = source;
+    dist[source] = 0;
+    queue[0] = source;
+    std::int64_t head = 0, tail = 1;
+    std::int64_t unexplored_edges = g.offsets[V] - g.Deg(source);
+    bool bottom_up = false;
+    int d = 0;
+    while (head < tail) {
+        if (!g.directed) {
+            std::int64_t frontier_edges = 0;
+            for (std::int64_t i = head; i < tail; i++) {
+                frontier_edges += g.Deg(queue[i]);
+            }
+            if (!bottom_up && frontier_edges > unexplored_edges / alpha)
+                bottom_up = true;
+            else if (bottom_up && (tail - head) < V / beta)
+                bottom_up = false;
+        }
+
+        std::int64_t next;
+        if (bottom_up) {
+            next = parallel ? BottomUpParallel(g, head, tail, d, *pool) : BottomUp(g, head, tail, d);
+            bottom_up_levels++;
+        }
+        else {
+            next = parallel ? TopDownParallel(g, head, tail, d, *pool) : TopDown(g, head, tail, d);
+        }
+        unexplored_edges -= scout_count;
+        head = tail;
+        tail = next;
+        visited_count = tail;
+        levels++;
+        d++;
+    }
+}
+
+bool BFS::PathTo(int v, std::vector<int>& path) const {
+    if (dist[v] == -1)
+        return false;
+    path.resize(dist[v] + 1);
+    for (int i = dist[v]; i >= 0; i--) {
+        path[i] = v;
+        v = st[v];
+    }
+    return true;
+}
+
+std::int64_t BFS::TopDown(const GraphView& g, std::int64_t head, std::int64_t tail, int d) {
+    std::int64_t next = tail;
+    scout_count = 0;
+    for (std::int64_t i = head; i < tail; i++) {
+        int u = queue[i];
+        for (int v : g.Adj(u)) {
+            if (dist[v] == -1) {
+                dist[v] = d + 1;
+                st[v] = u;
+                queue[next++] = v;
+                scout_count += g.Deg(v);
+            }
+        }
+    }
+    return next;
+}
+
+std::int64_t BFS::BottomUp(const GraphView& g, std::int64_t head, std::int64_t tail, int d) {
+    if (front.Size() != static_cast<std::size_t>(V))
+        front.Resize(V);
+    else
+        front.Reset();
+    for (std::int64_t i = head; i < tail; i++) {
+        front.Set(queue[i]);
+    }
+
+    std::int64_t next = tail;
+    scout_count = 0;
+    for (int v = 0; v < V; v++) {
+        if (dist[v] != -1)
+            continue;
+        for (int u : g.Adj(v)) {
+            if (front.Test(u)) {
+                dist[v] = d + 1;
+                st[v] = u;
+                queue[next++] = v;
+                scout_count += g.Deg(v);
+                break;
+            }
+        }
+    }
+    return next;
+}
+
+std::int64_t BFS::TopDownParallel(const GraphView& g, std::int64_t head, std::int64_t tail, int d, ThreadPool& pool) {
+    std::atomic<std::int64_t> next(tail);
+    std::atomic<std::int64_t> scout(0);
+    pool.ParallelFor(tail - head, kTopDownGrain, [&](std::int64_t b, std::int64_t e, int tid) {
+        auto& local = locals[tid];
+        local.clear();
+        std::int64_t degrees = 0;
+        for (std::int64_t i = head + b; i < head + e; i++) {
+            int u = queue[i];
+            for (int v : g.Adj(u)) {
+                if (visited.TestAndSet(v)) {
+                    dist[v] = d + 1;
+                    st[v] = u;
+                    local.push_back(v);
+                    degrees += g.Deg(v);
+                }
+            }
+        }
+        std::int64_t k = next.fetch_add(local.size(), std::memory_order_relaxed);
+        std::copy(local.begin(), local.end(), queue.begin() + k);
+        scout.fetch_add(degrees, std::memory_order_relaxed);
+    });
+    scout_count = scout.load();
+    return next.load();
+}
+
+std::int64_t BFS::BottomUpParallel(const GraphView& g, std::int64_t head, std::int64_t tail, int d, ThreadPool& pool) {
+    front_atomic.Reset();
+    pool.ParallelFor(tail - head, kBottomUpGrain, [&](std::int64_t b, std::int64_t e, int) {
+        for (std::int64_t i = head + b; i < head + e; i++) {
+            front_atomic.Set(queue[i]);
+        }
+    });
+
+    std::atomic<std::int64_t> next(tail);
+    std::atomic<std::int64_t> scout(0);
+    pool.ParallelFor(V, kBottomUpGrain, [&](std::int64_t b, std::int64_t e, int tid) {
+        auto& local = locals[tid];
+        local.clear();
+        std::int64_t degrees = 0;
+        for (int v = static_cast<int>(b); v < e; v++) {
+            if (visited.Test(v))
+                continue;
+            for (int u : g.Adj(v)) {
+                if (front_atomic.Test(u)) {
+                    visited.Set(v);
+                    dist[v] = d + 1;
+                    st[v] = u;
+                    local.push_back(v);
+                    degrees += g.Deg(v);
+                    break;
+                }
+            }
+        }
+        std::int64_t k = next.fetch_add(local.size(), std::memory_order_relaxed);
+        std::copy(local.begin(), local.end(), queue.begin() + k);
+        scout.fetch_add(degrees, std::memory_order_relaxed);
+    });
+    scout_count = scout.load();
+    return next.load();
+}
 
 } // namespace alg
@@ -1,16 +1,51 @@
 #pragma once
 #include <vector>
 #include <algorithm>
-#include <unordered_map>
-#include <stack>
+#include <ostream>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 
 #include "alg/common/common.h"
+#include "alg/common/bitmap.h"
+#include "alg/common/thread_pool.h"
+#include "csr.h"
 
 namespace alg {
 
+/**
+ * @brief Text rendering of the trees of a DFS forest
+ *
+ * Children lists are gathered once into CSR form from the parent links, in
+ * vertex order, and every vertex gets its column (tree depth) and row (the
+ * parent's row plus its rank among the siblings). Any number of trees can
+ * then be streamed, each in time linear in its size.
+ */
+class DfsTreeLayout {
+public:
+    explicit DfsTreeLayout(const std::vector<int>& st);
+
+    /**
+     * @brief Write the tree rooted at root
+     */
+    void Write(std::ostream& os, int root) const;
+
+    /**
+     * @brief Write every tree, roots in vertex order
+     */
+    void WriteAll(std::ostream& os) const;
+
+public:
+    int V;
+    std::vector<int> roots;
+    // children of u are children[offsets[u], offsets[u + 1])
+    std::vector<int> offsets;
+    std::vector<int> children;
+    // column and row of every vertex in its tree
+    std::vector<int> ws;
+    std::vector<int> ds;
+};
+
 class DFS {
 public:
     DFS(int v)
@@ -26,27 +61,37 @@ public:
      * @brief Print all the connected components in tree
      */
     void ShowTree() const {
-        const auto roots = Roots();
-        for (int root : roots) {
-            std::cout << ToString(root);
-        }
+        DfsTreeLayout(st).WriteAll(std::cout);
     }
     /**
      * @brief Print all the connected components
      */
     void ShowCC() const {
-        std::unordered_map<int, std::vector<int>> components;
         int max_id = -1;
         for (int i = 0; i < V; i++) {
-            components[cc[i]].push_back(i);
             if (cc[i] > max_id)
                 max_id = cc[i];
         }
+        // group vertices by id with a counting sort
+        std::vector<int> offsets(max_id + 2, 0);
+        for (int i = 0; i < V; i++) {
+            if (cc[i] != -1)
+                offsets[cc[i] + 1]++;
+        }
+        for (int i = 0; i <= max_id; i++) {
+            offsets[i + 1] += offsets[i];
+        }
+        std::vector<int> members(offsets[max_id + 1]);
+        for (int i = 0; i < V; i++) {
+            if (cc[i] != -1)
+                members[offsets[cc[i]]++] = i;
+        }
+        int first = 0;
         for (int i = 0; i <= max_id; i++) {
-            const auto& nodes = components[i];
-            for (int u : nodes) {
-                std::cout << u << ",";
+            for (int k = first; k < offsets[i]; k++) {
+                std::cout << members[k] << ",";
             }
+            first = offsets[i];
             std::cout << std::endl;
         }
     }
@@ -91,42 +136,22 @@ public:
 
     /**
      * @brief convert connected component[cc] to string
+     *
+     * Lays out the whole forest in O(V) on every call. To print many trees,
+     * build one DfsTreeLayout of st and pass it to the overload below.
      */
     std::string ToString(int cc) const {
-        std::ostringstream oss;
-
-        auto succ = Succ();
-
-        std::vector<int> ws, ds;
-        WidthAndDepth(ws, ds);
-
-        int node_width = NodeWidth();
-        int cur_depth = 0;
-        std::stack<int> st;
-        st.push(Root(cc));
-        while (!st.empty()) {
-            int u = STpop(st);
-
-            if (ds[u] != cur_depth) {
-                oss << std::endl;
-                int prefix_size = ws[u] * (node_width + 1);
-                for (int i = 0; i < prefix_size - 1; i++)
-                    oss << " ";
-                oss << "|" << std::endl;
-                for (int i = 0; i < prefix_size; i++)
-                    oss << " ";
-
-                cur_depth = ds[u];
-            }
-            oss << "-" << std::setw(node_width) << std::right << u;
-
-            const auto& p = succ[u];
-            for (int i = p.size() - 1; i >= 0; i--) {
-                st.push(p[i]);
-            }
-        }
-        oss << std::endl;
+        return ToString(cc, DfsTreeLayout(st));
+    }
 
+    /**
+     * @brief convert connected component[cc] to string, with a layout of st
+     */
+    std::string ToString(int cc, const DfsTreeLayout& layout) const {
+        std::ostringstream oss;
+        const int root = Root(cc);
+        if (root != -1)
+            layout.Write(oss, root);
         return oss.str();
     }
 
@@ -164,55 +189,27 @@ public:
         return roots;
     }
     std::vector<int> RootsCC() const {
-        std::vector<int> roots;
-        std::unordered_map<int, std::vector<int>> components;
         int max_id = -1;
         for (int i = 0; i < V; i++) {
-            components[cc[i]].push_back(i);
             if (cc[i] > max_id)
                 max_id = cc[i];
         }
-        for (int i = 0; i <= max_id; i++) {
-            roots.push_back(components[i][0]);
+        // smallest vertex of every component
+        std::vector<int> roots(max_id + 1, -1);
+        for (int i = V - 1; i >= 0; i--) {
+            if (cc[i] != -1)
+                roots[cc[i]] = i;
         }
         return roots;
     }
 
-    /**
-     * @brief Children links
-     */
-    std::unordered_map<int, std::vector<int>> Succ() const {
-        std::unordered_map<int, std::vector<int>> post;
-        for (int i = 0; i < V; i++) {
-            if (st[i] != -1 && st[i] != i) {
-                post[st[i]].push_back(i);
-            }
-        }
-        return post;
-    }
-
-    void WidthAndDepthR(int u, int w, int d,
-                        std::unordered_map<int, std::vector<int>>& post,
-                        std::vector<int>& ws, std::vector<int>& ds) const {
-        ws[u] = w;
-        ds[u] = d;
-        for (int i : post[u]) {
-            WidthAndDepthR(i, w + 1, d, post, ws, ds);
-            d++;
-        }
-    }
-
     /**
      * @brief Width and depth for show
      */
     void WidthAndDepth(std::vector<int>& ws, std::vector<int>& ds) const {
-        ws.resize(V);
-        ds.resize(V);
-        auto succ = Succ();
-        auto roots = Roots();
-        for (int root : roots) {
-            WidthAndDepthR(root, 0, 0, succ, ws, ds);
-        }
+        DfsTreeLayout layout(st);
+        ws = std::move(layout.ws);
+        ds = std::move(layout.ds);
     }
 
 public:
@@ -229,11 +226,84 @@ public:
     std::vector<int> low;
 };
 
+/**
+ * @brief Direction-optimizing breadth first search
+ *
+ * Frontiers are expanded top-down while they are small and bottom-up (every
+ * unvisited vertex looks for a parent in the frontier) once the frontier
+ * covers a large part of the remaining edges. Bottom-up steps need in-edges,
+ * so they are only taken on undirected graphs. With a pool of more than one
+ * thread every level is expanded in parallel, vertices being claimed through
+ * an atomic visited bitmap.
+ *
+ * Buffers are kept between runs and only the vertices reached by the previous
+ * run are reset, so repeated queries do not reallocate.
+ */
 class BFS {
 public:
-private:
+    BFS(int v)
+        : V(v) {
+        st = std::vector<int>(V, -1);
+        dist = std::vector<int>(V, -1);
+        queue = std::vector<int>(V);
+    }
+
+    /**
+     * @brief Search from source, pool is optional
+     */
+    void Run(const GraphView& g, int source, ThreadPool* pool = nullptr);
+
+    bool Reachable(int u) const {
+        return dist[u] != -1;
+    }
+
+    /**
+     * @brief Path from the last source to v
+     */
+    bool PathTo(int v, std::vector<int>& path) const;
+
+    /**
+     * @brief Vertices reached by the last run in visiting order
+     */
+    std::vector<int> Order() const {
+        return std::vector<int>(queue.begin(), queue.begin() + visited_count);
+    }
+
+    void Reset();
+
+public:
     int V;
+    // parent link
+    std::vector<int> st;
+    // hop distance from source
+    std::vector<int> dist;
+
+    // switch to bottom-up when frontier edges > unexplored edges / alpha
+    int alpha = 15;
+    // switch back to top-down when frontier vertices < V / beta
+    int beta = 18;
+
+    // statistics of the last run
+    int levels = 0;
+    int bottom_up_levels = 0;
+
+private:
+    std::int64_t TopDown(const GraphView& g, std::int64_t head, std::int64_t tail, int d);
+    std::int64_t BottomUp(const GraphView& g, std::int64_t head, std::int64_t tail, int d);
+    std::int64_t TopDownParallel(const GraphView& g, std::int64_t head, std::int64_t tail, int d, ThreadPool& pool);
+    std::int64_t BottomUpParallel(const GraphView& g, std::int64_t head, std::int64_t tail, int d, ThreadPool& pool);
+
+private:
+    // all visited vertices, one contiguous segment per level
+    std::vector<int> queue;
+    std::int64_t visited_count = 0;
+    // degree sum of the vertices appended by the last step
+    std::int64_t scout_count = 0;
 
+    Bitmap front;
+    AtomicBitmap visited;
+    AtomicBitmap front_atomic;
+    std::vector<std::vector<int>> locals;
 };
 
 } // namespace alg
@@ -0,0 +1,499 @@
+#pragma once
+#include <map>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+#include "alg/common/thread_pool.h"
+#include "alg/data/indexed_heap.h"
+#include "alg/data/radix_heap.h"
+#include "weighted_csr.h"
+
+namespace alg {
+
+/**
+ * @brief Type of a path length over weights W, int64 for integer weights
+ */
+template <typename W>
+using Distance = typename std::conditional<std::is_integral<W>::value, std::int64_t, W>::type;
+
+/**
+ * @brief Largest distance, marks an unreached vertex
+ */
+template <typename W>
+constexpr Distance<W> Unreached() {
+    return std::numeric_limits<Distance<W>>::max();
+}
+
+/**
+ * @brief Walk parent links st back from v, path is empty if v was not reached
+ */
+inline bool PathFromParents(const std::vector<int>& st, int v, std::vector<int>& path) {
+    path.clear();
+    if (st[v] == -1)
+        return false;
+    while (st[v] != v) {
+        path.push_back(v);
+        v = st[v];
+    }
+    path.push_back(v);
+    std::reverse(path.begin(), path.end());
+    return true;
+}
+
+/**
+ * @brief Dijkstra's single source shortest paths with a pluggable heap
+ *
+ * Heap is a DaryHeap (decrease-key) or a RadixHeap (integer weights only,
+ * stale entries are skipped on pop). dist and st are sized once and only
+ * the vertices touched by the last run are reset, so repeated point to
+ * point queries on a large graph cost the size of the search, not V.
+ * Weights must be non-negative. The graph must outlive the engine.
+ */
+template <typename W, typename Heap = QuadHeap<Distance<W>>>
+class Dijkstra {
+public:
+    using Dist = Distance<W>;
+
+    explicit Dijkstra(const WeightedGraphView<W>& graph)
+        : dist(graph.V, Unreached<W>()),
+          st(graph.V, -1),
+          g(graph),
+          heap(graph.V) {}
+
+    /**
+     * @brief Distances from source to every reachable vertex
+     */
+    void Run(int source) {
+        Search(source, -1, [](int) { return Dist(0); });
+    }
+
+    /**
+     * @brief Distance from source to target, stops once target is settled
+     */
+    Dist Run(int source, int target) {
+        return Search(source, target, [](int) { return Dist(0); });
+    }
+
+    /**
+     * @brief A* from source to target
+     *
+     * h(v) is a lower bound of the distance from v to target and must be
+     * consistent, h(u) <= w(u, v) + h(v), so that a settled vertex is final.
+     */
+    template <typename Heuristic>
+    Dist Run(int source, int target, Heuristic h) {
+        return Search(source, target, h);
+    }
+
+    bool Reached(int v) const {
+        return st[v] != -1;
+    }
+
+    /**
+     * @brief Shortest path from the last source to v
+     */
+    bool PathTo(int v, std::vector<int>& path) const {
+        return PathFromParents(st, v, path);
+    }
+
+    /**
+     * @brief Vertices labeled by the last run
+     */
+    const std::vector<int>& Touched() const {
+        return touched;
+    }
+
+    void Reset() {
+        for (int v : touched) {
+            dist[v] = Unreached<W>();
+            st[v] = -1;
+        }
+        touched.clear();
+        heap.Clear();
+    }
+
+public:
+    std::vector<Dist> dist;
+    std::vector<int> st;
+
+private:
+    template <typename Heuristic>
+    Dist Search(int source, int target, Heuristic h) {
+        Reset();
+        dist[source] = 0;
+        st[source] = source;
+        touched.push_back(source);
+        heap.Push(source, h(source));
+        while (!heap.Empty()) {
+            Dist key;
+            int u = heap.Pop(key);
+            // lazy heaps keep the copies of a lowered key
+            if (dist[u] + h(u) < key)
+                continue;
+            if (u == target)
+                return dist[u];
+
+            const Dist du = dist[u];
+            for (const auto& a : g.Edges(u)) {
+                const Dist nd = du + a.w;
+                if (nd < dist[a.v]) {
+                    if (st[a.v] == -1)
+                        touched.push_back(a.v);
+                    dist[a.v] = nd;
+                    st[a.v] = u;
+                    heap.Push(a.v, nd + h(a.v));
+                }
+            }
+        }
+        return target == -1 ? Dist(0) : dist[target];
+    }
+
+private:
+    WeightedGraphView<W> g;
+    Heap heap;
+    std::vector<int> touched;
+};
+
+template <typename W>
+using BinaryDijkstra = Dijkstra<W, BinaryHeap<Distance<W>>>;
+
+template <typename W>
+using RadixDijkstra = Dijkstra<W, RadixHeap<Distance<W>>>;
+
+/**
+ * @brief Bidirectional Dijkstra for point to point queries
+ *
+ * Searches forward from s on the graph and backward from t on its
+ * transpose, always expanding the side with the smaller top key, and stops
+ * once the two tops add up to the best meeting distance. The A* variant
+ * adds a potential to the keys of both sides. For an undirected graph both
+ * sides share it. The graphs must outlive the engine.
+ */
+template <typename W>
+class BidirectionalDijkstra {
+public:
+    using Dist = Distance<W>;
+
+    explicit BidirectionalDijkstra(const WeightedGraphView<W>& graph)
+        : BidirectionalDijkstra(graph, graph) {}
+
+    BidirectionalDijkstra(const WeightedGraphView<W>& forward, const WeightedGraphView<W>& backward)
+        : sides{Side(forward), Side(backward)} {}
+
+    /**
+     * @brief Distance from s to t, Unreached<W>() if there is no path
+     */
+    Dist Run(int s, int t) {
+        return Search(s, t, Dist(1), [](int) { return Dist(0); });
+    }
+
+    /**
+     * @brief Bidirectional A* from s to t
+     *
+     * to_target(v) and from_source(v) are consistent lower bounds of the
+     * distance from v to t and from s to v. Both sides use the average
+     * potential (to_target(v) - from_source(v)) / 2, the forward side adding
+     * it to its keys and the backward side subtracting it, so the weights
+     * stay non-negative for both and the plain stopping rule still holds.
+     * Keys are doubled to keep integer potentials exact.
+     */
+    template <typename ToTarget, typename FromSource>
+    Dist Run(int s, int t, ToTarget to_target, FromSource from_source) {
+        return Search(s, t, Dist(2), [&](int v) { return to_target(v) - from_source(v); });
+    }
+
+    /**
+     * @brief Shortest path of the last query
+     */
+    bool Path(std::vector<int>& path) const {
+        path.clear();
+        if (meet == -1)
+            return false;
+        PathFromParents(sides[0].st, meet, path);
+        for (int v = meet; v != target; ) {
+            v = sides[1].st[v];
+            path.push_back(v);
+        }
+        return true;
+    }
+
+    void Reset() {
+        sides[0].Reset();
+        sides[1].Reset();
+        meet = -1;
+    }
+
+private:
+    struct Side {
+        explicit Side(const WeightedGraphView<W>& graph)
+            : g(graph),
+              dist(graph.V, Unreached<W>()),
+              st(graph.V, -1),
+              heap(graph.V) {}
+
+        void Start(int v, Dist key) {
+            dist[v] = 0;
+            st[v] = v;
+            touched.push_back(v);
+            heap.Push(v, key);
+        }
+
+        void Reset() {
+            for (int v : touched) {
+                dist[v] = Unreached<W>();
+                st[v] = -1;
+            }
+            touched.clear();
+            heap.Clear();
+        }
+
+        WeightedGraphView<W> g;
+        std::vector<Dist> dist;
+        std::vector<int> st;
+        std::vector<int> touched;
+        QuadHeap<Dist> heap;
+    };
+
+    // keys are scale * dist + p(v) forward and scale * dist - p(v) backward
+    template <typename Potential>
+    Dist Search(int s, int t, Dist scale, const Potential& p) {
+        Reset();
+        source = s;
+        target = t;
+        sides[0].Start(s, p(s));
+        sides[1].Start(t, -p(t));
+        best = s == t ? Dist(0) : Unreached<W>();
+        meet = s == t ? s : -1;
+
+        while (!sides[0].heap.Empty() && !sides[1].heap.Empty()) {
+            const Dist top_f = sides[0].heap.TopKey();
+            const Dist top_r = sides[1].heap.TopKey();
+            if (best != Unreached<W>() && top_f + top_r >= scale * best)
+                break;
+            Expand(top_f <= top_r ? 0 : 1, scale, p);
+        }
+        return best;
+    }
+
+    template <typename Potential>
+    void Expand(int k, Dist scale, const Potential& p) {
+        Side& side = sides[k];
+        const Side& other = sides[1 - k];
+        Dist key;
+        int u = side.heap.Pop(key);
+        const Dist du = side.dist[u];
+        for (const auto& a : side.g.Edges(u)) {
+            const Dist nd = du + a.w;
+            if (nd < side.dist[a.v]) {
+                if (side.st[a.v] == -1)
+                    side.touched.push_back(a.v);
+                side.dist[a.v] = nd;
+                side.st[a.v] = u;
+                side.heap.Push(a.v, scale * nd + (k == 0 ? p(a.v) : -p(a.v)));
+            }
+            if (other.st[a.v] != -1 && side.dist[a.v] + other.dist[a.v] < best) {
+                best = side.dist[a.v] + other.dist[a.v];
+                meet = a.v;
+            }
+        }
+    }
+
+private:
+    Side sides[2];
+    int source = -1;
+    int target = -1;
+    int meet = -1;
+    Dist best = Unreached<W>();
+};
+
+/**
+ * @brief Parallel delta-stepping single source shortest paths
+ *
+ * Bucket i holds the vertices with a tentative distance in
+ * [i * delta, (i + 1) * delta). A bucket is drained by relaxing its light
+ * edges (w <= delta) until it stays empty, then the heavy edges of every
+ * vertex it settled are relaxed once. Distances are lowered with an atomic
+ * compare-and-swap min, the relaxed vertices are gathered per thread and
+ * merged into the buckets between rounds. Only non-empty buckets exist,
+ * kept in an ordered map, so memory follows the queued vertices and not
+ * the longest distance over delta. Parents are set afterwards by a search
+ * from the source along the edges with dist[u] + w == dist[v], so zero
+ * weights cannot close a cycle of parents.
+ */
+template <typename W>
+class DeltaStepping {
+public:
+    using Dist = Distance<W>;
+
+    explicit DeltaStepping(const WeightedGraphView<W>& graph)
+        : dist(graph.V, Unreached<W>()),
+          st(graph.V, -1),
+          g(graph),
+          tentative(new std::atomic<Dist>[graph.V]),
+          done(graph.V, Unreached<W>()) {}
+
+    /**
+     * @brief Mean edge weight, at least 1 for integer weights
+     */
+    static Dist DefaultDelta(const WeightedGraphView<W>& graph) {
+        const std::int64_t arcs = graph.offsets[graph.V];
+        Dist sum = 0;
+        for (std::int64_t k = 0; k < arcs; k++) {
+            sum += graph.weights[k];
+        }
+        Dist delta = arcs == 0 ? Dist(1) : sum / static_cast<Dist>(arcs);
+        return delta > 0 ? delta : Dist(1);
+    }
+
+    void Run(int source, ThreadPool* pool = nullptr) {
+        Run(source, DefaultDelta(g), pool);
+    }
+
+    /**
+     * @brief Run with bucket width delta, false if delta is not positive
+     */
+    bool Run(int source, Dist delta, ThreadPool* pool) {
+        if (!(delta > 0))
+            return false;
+        const int V = g.V;
+        for (int v = 0; v < V; v++) {
+            tentative[v].store(Unreached<W>(), std::memory_order_relaxed);
+        }
+        std::fill(done.begin(), done.end(), Unreached<W>());
+        locals.assign(pool ? pool->Size() : 1, std::vector<Request>());
+        buckets.clear();
+        buckets[0].push_back(source);
+        tentative[source].store(0, std::memory_order_relaxed);
+
+        std::vector<int> frontier, settled;
+        while (!buckets.empty()) {
+            // relaxing never lowers a distance below the current bucket
+            const std::size_t i = buckets.begin()->first;
+            settled.clear();
+            while (!buckets.empty() && buckets.begin()->first == i) {
+                frontier.clear();
+                frontier.swap(buckets.begin()->second);
+                buckets.erase(buckets.begin());
+                // drop vertices moved to a lower distance or already relaxed at it
+                std::size_t n = 0;
+                for (int v : frontier) {
+                    Dist d = tentative[v].load(std::memory_order_relaxed);
+                    if (Bucket(d, delta) == i && done[v] != d) {
+                        done[v] = d;
+                        frontier[n++] = v;
+                    }
+                }
+                frontier.resize(n);
+                settled.insert(settled.end(), frontier.begin(), frontier.end());
+                Relax(frontier, delta, true, pool);
+            }
+            Relax(settled, delta, false, pool);
+        }
+
+        for (int v = 0; v < V; v++) {
+            dist[v] = tentative[v].load(std::memory_order_relaxed);
+        }
+        Parents(source, frontier);
+        return true;
+    }
+
+    bool Reached(int v) const {
+        return st[v] != -1;
+    }
+
+    bool PathTo(int v, std::vector<int>& path) const {
+        return PathFromParents(st, v, path);
+    }
+
+public:
+    std::vector<Dist> dist;
+    std::vector<int> st;
+
+private:
+    struct Request {
+        int v;
+        std::size_t bucket;
+    };
+
+    static std::size_t Bucket(Dist d, Dist delta) {
+        // a tiny float delta must not overflow the index, a capped bucket
+        // is drained like any other until it stays empty
+        constexpr std::size_t kLast = std::size_t(1) << 62;
+        const Dist b = d / delta;
+        return b < static_cast<Dist>(kLast) ? static_cast<std::size_t>(b) : kLast;
+    }
+
+    static bool AtomicMin(std::atomic<Dist>& a, Dist d) {
+        Dist old = a.load(std::memory_order_relaxed);
+        while (d < old) {
+            if (a.compare_exchange_weak(old, d, std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+
+    void RelaxRange(const std::vector<int>& list, std::int64_t begin, std::int64_t end,
+                    Dist delta, bool light, std::vector<Request>& out) {
+        for (std::int64_t i = begin; i < end; i++) {
+            const int u = list[i];
+            const Dist du = tentative[u].load(std::memory_order_relaxed);
+            for (const auto& a : g.Edges(u)) {
+                if ((a.w <= delta) != light)
+                    continue;
+                const Dist nd = du + a.w;
+                if (AtomicMin(tentative[a.v], nd))
+                    out.push_back(Request{a.v, Bucket(nd, delta)});
+            }
+        }
+    }
+
+    void Relax(const std::vector<int>& list, Dist delta, bool light, ThreadPool* pool) {
+        if (pool && list.size() > 256) {
+            pool->ParallelFor(list.size(), 64, [&](std::int64_t begin, std::int64_t end, int tid) {
+                RelaxRange(list, begin, end, delta, light, locals[tid]);
+            });
+        }
+        else {
+            RelaxRange(list, 0, list.size(), delta, light, locals[0]);
+        }
+
+        for (auto& local : locals) {
+            for (const auto& r : local) {
+                buckets[r.bucket].push_back(r.v);
+            }
+            local.clear();
+        }
+    }
+
+    void Parents(int source, std::vector<int>& stack) {
+        std::fill(st.begin(), st.end(), -1);
+        st[source] = source;
+        stack.assign(1, source);
+        while (!stack.empty()) {
+            const int u = stack.back();
+            stack.pop_back();
+            for (const auto& a : g.Edges(u)) {
+                if (st[a.v] == -1 && dist[u] + a.w == dist[a.v]) {
+                    st[a.v] = u;
+                    stack.push_back(a.v);
+                }
+            }
+        }
+    }
+
+private:
+    WeightedGraphView<W> g;
+    std::unique_ptr<std::atomic<Dist>[]> tentative;
+    // distance each vertex last had its light edges relaxed at
+    std::vector<Dist> done;
+    // non-empty buckets by index
+    std::map<std::size_t, std::vector<int>> buckets;
+    std::vector<std::vector<Request>> locals;
+};
+
+} // namespace alg
@@ -0,0 +1,396 @@
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+
+#include "static_name_index.h"
+
+namespace alg {
+namespace {
+constexpr char kHashMagic[8] = {'A', 'L', 'G', 'M', 'P', 'H', 'F', '1'};
+constexpr char kTrieMagic[8] = {'A', 'L', 'G', 'D', 'A', 'T', 'R', '1'};
+
+std::size_t Align8(std::size_t bytes) {
+    return (bytes + 7) & ~std::size_t(7);
+}
+
+// FNV-1a, mixed per level by Position
+std::uint64_t HashName(const char* name) {
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    for (; *name; name++) {
+        h = (h ^ static_cast<unsigned char>(*name)) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+// bit of hash h in a level of size bits
+std::uint64_t Position(std::uint64_t h, std::uint64_t level, std::uint64_t size) {
+    h ^= (level + 1) * 0x9e3779b97f4a7c15ull;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return static_cast<std::uint64_t>((static_cast<unsigned __int128>(h) * size) >> 64);
+}
+
+// input order of names sorted bytewise, empty if two are equal
+std::vector<int> SortedOrder(const std::vector<std::string>& names) {
+    std::vector<int> order(names.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int x, int y) {
+        return names[x] < names[y];
+    });
+    for (std::size_t k = 1; k < order.size(); k++) {
+        if (names[order[k - 1]] == names[order[k]])
+            return {};
+    }
+    return order;
+}
+
+bool Aligned(const void* blob) {
+    return reinterpret_cast<std::uintptr_t>(blob) % 8 == 0;
+}
+} // namespace
+
+struct PerfectNameHash::Header {
+    char magic[8];
+    std::uint64_t n;
+    std::uint64_t levels;
+    std::uint64_t words;
+    std::uint64_t chars;
+
+    // byte offsets of the sections, the last one is the blob size
+    void Layout(std::size_t at[6]) const {
+        at[0] = sizeof(Header);
+        at[1] = at[0] + (levels + 1) * sizeof(std::uint64_t);
+        at[2] = at[1] + words * sizeof(std::uint64_t);
+        at[3] = at[2] + Align8(words * sizeof(std::uint32_t));
+        at[4] = at[3] + Align8(n * sizeof(std::int32_t));
+        at[5] = at[4] + (n + 1) * sizeof(std::uint64_t) + Align8(chars);
+    }
+};
+
+bool PerfectNameHash::Build(const std::vector<std::string>& names) {
+    constexpr double kGamma = 2.0;
+    constexpr std::size_t kMaxLevels = 64;
+
+    const std::size_t count = names.size();
+    // equal names collide on every level
+    if (count > 1 && SortedOrder(names).empty())
+        return false;
+
+    std::vector<std::uint64_t> hashes(count);
+    std::vector<std::uint32_t> rest(count);
+    for (std::size_t i = 0; i < count; i++) {
+        hashes[i] = HashName(names[i].c_str());
+        rest[i] = static_cast<std::uint32_t>(i);
+    }
+
+    // each level keeps the keys that hit a bit alone, the rest move on
+    std::vector<std::uint64_t> begin = {0};
+    std::vector<std::uint64_t> all_bits;
+    std::vector<std::uint64_t> position(count);
+    std::vector<std::uint64_t> seen, clash;
+    std::vector<std::uint32_t> next;
+    while (!rest.empty()) {
+        if (begin.size() > kMaxLevels)
+            return false;
+        const std::uint64_t level = begin.size() - 1;
+        const std::size_t words = static_cast<std::size_t>(kGamma * rest.size() + 63) / 64;
+        const std::uint64_t size = words * 64;
+        seen.assign(words, 0);
+        clash.assign(words, 0);
+        for (std::uint32_t i : rest) {
+            const std::uint64_t p = Position(hashes[i], level, size);
+            const std::uint64_t bit = 1ull << (p % 64);
+            if (seen[p / 64] & bit)
+                clash[p / 64] |= bit;
+            seen[p / 64] |= bit;
+        }
+        next.clear();
+        for (std::uint32_t i : rest) {
+            const std::uint64_t p = Position(hashes[i], level, size);
+            if (clash[p / 64] >> (p % 64) & 1)
+                next.push_back(i);
+            else
+                position[i] = begin.back() + p;
+        }
+        for (std::size_t w = 0; w < words; w++) {
+            all_bits.push_back(seen[w] & ~clash[w]);
+        }
+        begin.push_back(begin.back() + size);
+        rest.swap(next);
+    }
+
+    Header header;
+    std::memcpy(header.magic, kHashMagic, sizeof(kHashMagic));
+    header.n = count;
+    header.levels = begin.size() - 1;
+    header.words = all_bits.size();
+    header.chars = 0;
+    for (const std::string& name : names) {
+        header.chars += name.size() + 1;
+    }
+    std::size_t at[6];
+    header.Layout(at);
+    owned.assign(at[5] / 8, 0);
+    char* blob = reinterpret_cast<char*>(owned.data());
+
+    std::memcpy(blob, &header, sizeof(header));
+    std::memcpy(blob + at[0], begin.data(), begin.size() * sizeof(std::uint64_t));
+    std::copy(all_bits.begin(), all_bits.end(), reinterpret_cast<std::uint64_t*>(blob + at[1]));
+    std::uint32_t* rank = reinterpret_cast<std::uint32_t*>(blob + at[2]);
+    std::uint32_t total = 0;
+    for (std::size_t w = 0; w < all_bits.size(); w++) {
+        rank[w] = total;
+        total += __builtin_popcountll(all_bits[w]);
+    }
+
+    // slot of a key is the rank of its bit, names are stored in slot order
+    std::vector<std::uint32_t> key_of(count);
+    for (std::size_t i = 0; i < count; i++) {
+        const std::uint64_t p = position[i];
+        const std::uint64_t below = all_bits[p / 64] & ((1ull << (p % 64)) - 1);
+        key_of[rank[p / 64] + __builtin_popcountll(below)] = static_cast<std::uint32_t>(i);
+    }
+    std::int32_t* id = reinterpret_cast<std::int32_t*>(blob + at[3]);
+    std::uint64_t* offset = reinterpret_cast<std::uint64_t*>(blob + at[4]);
+    char* text = blob + at[4] + (count + 1) * sizeof(std::uint64_t);
+    offset[0] = 0;
+    for (std::size_t slot = 0; slot < count; slot++) {
+        const std::string& name = names[key_of[slot]];
+        id[slot] = static_cast<std::int32_t>(key_of[slot]);
+        std::memcpy(text + offset[slot], name.c_str(), name.size() + 1);
+        offset[slot + 1] = offset[slot] + name.size() + 1;
+    }
+    return Attach(blob, at[5]);
+}
+
+bool PerfectNameHash::View(const void* blob, std::size_t bytes) {
+    owned.clear();
+    owned.shrink_to_fit();
+    return Attach(static_cast<const char*>(blob), bytes);
+}
+
+bool PerfectNameHash::Attach(const char* blob, std::size_t bytes) {
+    // moving keeps the buffer blob may point into
+    std::vector<std::uint64_t> keep = std::move(owned);
+    *this = PerfectNameHash();
+    owned = std::move(keep);
+    Header header;
+    if (!Aligned(blob) || bytes < sizeof(header))
+        return false;
+    std::memcpy(&header, blob, sizeof(header));
+    if (std::memcmp(header.magic, kHashMagic, sizeof(kHashMagic)) != 0 || header.n > 0x7fffffff)
+        return false;
+    std::size_t at[6];
+    header.Layout(at);
+    if (at[5] > bytes)
+        return false;
+
+    data = blob;
+    size = at[5];
+    n = static_cast<int>(header.n);
+    levels = static_cast<int>(header.levels);
+    level_begin = reinterpret_cast<const std::uint64_t*>(blob + at[0]);
+    bits = reinterpret_cast<const std::uint64_t*>(blob + at[1]);
+    ranks = reinterpret_cast<const std::uint32_t*>(blob + at[2]);
+    ids = reinterpret_cast<const std::int32_t*>(blob + at[3]);
+    name_at = reinterpret_cast<const std::uint64_t*>(blob + at[4]);
+    chars = blob + at[4] + (header.n + 1) * sizeof(std::uint64_t);
+    return true;
+}
+
+int PerfectNameHash::IndexByName(const char* name) const {
+    const std::uint64_t h = HashName(name);
+    for (int l = 0; l < levels; l++) {
+        const std::uint64_t first = level_begin[l];
+        const std::uint64_t p = first + Position(h, l, level_begin[l + 1] - first);
+        const std::uint64_t word = bits[p / 64];
+        const std::uint64_t bit = 1ull << (p % 64);
+        if (word & bit) {
+            const std::uint32_t slot = ranks[p / 64] + __builtin_popcountll(word & (bit - 1));
+            return std::strcmp(chars + name_at[slot], name) == 0 ? ids[slot] : -1;
+        }
+    }
+    return -1;
+}
+
+struct DoubleArrayTrie::Header {
+    char magic[8];
+    std::uint64_t n;
+    std::uint64_t cells;
+
+    void Layout(std::size_t at[3]) const {
+        at[0] = sizeof(Header);
+        at[1] = at[0] + Align8(cells * sizeof(std::int32_t));
+        at[2] = at[1] + Align8(cells * sizeof(std::int32_t));
+    }
+};
+
+bool DoubleArrayTrie::Build(const std::vector<std::string>& names) {
+    const std::vector<int> order = SortedOrder(names);
+    if (order.size() != names.size())
+        return false;
+
+    // cell 0 is the root, free cells have check -1
+    std::vector<std::int32_t> base_of(1, 0);
+    std::vector<std::int32_t> check_of(1, 0);
+    auto grow = [&](std::size_t cell) {
+        if (cell >= check_of.size()) {
+            const std::size_t size = std::max(cell + 1, 2 * check_of.size());
+            base_of.resize(size, 0);
+            check_of.resize(size, -1);
+        }
+    };
+
+    // node covers the names order[lo, hi), which agree on depth bytes
+    struct Task {
+        std::int32_t node;
+        std::size_t lo, hi, depth;
+    };
+    std::vector<Task> stack;
+    if (!names.empty())
+        stack.push_back(Task{0, 0, names.size(), 0});
+    std::vector<int> codes;
+    std::vector<std::size_t> starts;
+    std::size_t first_free = 1;
+    while (!stack.empty()) {
+        const Task task = stack.back();
+        stack.pop_back();
+
+        // code 0 ends a name, sorting puts it first
+        codes.clear();
+        starts.clear();
+        for (std::size_t k = task.lo; k < task.hi; k++) {
+            const std::string& name = names[order[k]];
+            const int code = task.depth < name.size() ? static_cast<unsigned char>(name[task.depth]) + 1 : 0;
+            if (codes.empty() || codes.back() != code) {
+                codes.push_back(code);
+                starts.push_back(k);
+            }
+        }
+        starts.push_back(task.hi);
+
+        // lowest base that puts every child on a free cell
+        std::size_t b = first_free > static_cast<std::size_t>(codes[0]) ? first_free - codes[0] : 1;
+        b = std::max<std::size_t>(b, 1);
+        while (true) {
+            grow(b + codes.back());
+            bool fits = true;
+            for (int code : codes) {
+                if (check_of[b + code] != -1) {
+                    fits = false;
+                    break;
+                }
+            }
+            if (fits)
+                break;
+            b++;
+        }
+
+        base_of[task.node] = static_cast<std::int32_t>(b);
+        for (std::size_t j = 0; j < codes.size(); j++) {
+            const std::size_t cell = b + codes[j];
+            check_of[cell] = task.node;
+            if (codes[j] == 0)
+                base_of[cell] = -(order[starts[j]] + 1);
+            else
+                stack.push_back(Task{static_cast<std::int32_t>(cell), starts[j], starts[j + 1], task.depth + 1});
+        }
+        while (first_free < check_of.size() && check_of[first_free] != -1) {
+            first_free++;
+        }
+    }
+    while (check_of.size() > 1 && check_of.back() == -1) {
+        check_of.pop_back();
+    }
+
+    Header header;
+    std::memcpy(header.magic, kTrieMagic, sizeof(kTrieMagic));
+    header.n = names.size();
+    header.cells = check_of.size();
+    std::size_t at[3];
+    header.Layout(at);
+    owned.assign(at[2] / 8, 0);
+    char* blob = reinterpret_cast<char*>(owned.data());
+    std::memcpy(blob, &header, sizeof(header));
+    std::memcpy(blob + at[0], base_of.data(), header.cells * sizeof(std::int32_t));
+    std::memcpy(blob + at[1], check_of.data(), header.cells * sizeof(std::int32_t));
+    return Attach(blob, at[2]);
+}
+
+bool DoubleArrayTrie::View(const void* blob, std::size_t bytes) {
+    owned.clear();
+    owned.shrink_to_fit();
+    return Attach(static_cast<const char*>(blob), bytes);
+}
+
+bool DoubleArrayTrie::Attach(const char* blob, std::size_t bytes) {
+    // moving keeps the buffer blob may point into
+    std::vector<std::uint64_t> keep = std::move(owned);
+    *this = DoubleArrayTrie();
+    owned = std::move(keep);
+    Header header;
+    if (!Aligned(blob) || bytes < sizeof(header))
+        return false;
+    std::memcpy(&header, blob, sizeof(header));
+    if (std::memcmp(header.magic, kTrieMagic, sizeof(kTrieMagic)) != 0 || header.n > 0x7fffffff ||
+        header.cells == 0 || header.cells > 0x7fffffff)
+        return false;
+    std::size_t at[3];
+    header.Layout(at);
+    if (at[2] > bytes)
+        return false;
+
+    data = blob;
+    size = at[2];
+    n = static_cast<int>(header.n);
+    cells = static_cast<std::int64_t>(header.cells);
+    base = reinterpret_cast<const std::int32_t*>(blob + at[0]);
+    check = reinterpret_cast<const std::int32_t*>(blob + at[1]);
+    return true;
+}
+
+std::int32_t DoubleArrayTrie::Walk(const char* prefix) const {
+    if (n == 0)
+        return -1;
+    std::int32_t s = 0;
+    for (; *prefix; prefix++) {
+        const std::int64_t t = std::int64_t(base[s]) + static_cast<unsigned char>(*prefix) + 1;
+        if (t >= cells || check[t] != s)
+            return -1;
+        s = static_cast<std::int32_t>(t);
+    }
+    return s;
+}
+
+int DoubleArrayTrie::IndexByName(const char* name) const {
+    const std::int32_t s = Walk(name);
+    if (s == -1)
+        return -1;
+    const std::int32_t t = base[s];
+    return t < cells && check[t] == s ? -base[t] - 1 : -1;
+}
+
+void DoubleArrayTrie::WithPrefix(const char* prefix, std::vector<int>& result) const {
+    result.clear();
+    const std::int32_t root = Walk(prefix);
+    if (root == -1)
+        return;
+    std::vector<std::int32_t> stack = {root};
+    while (!stack.empty()) {
+        const std::int32_t s = stack.back();
+        stack.pop_back();
+        const std::int64_t b = base[s];
+        if (b < cells && check[b] == s)
+            result.push_back(-base[b] - 1);
+        // pushed in reverse so the smallest byte is expanded first
+        for (std::int64_t t = std::min<std::int64_t>(b + 256, cells - 1); t > b; t--) {
+            if (check[t] == s)
+                stack.push_back(static_cast<std::int32_t>(t));
+        }
+    }
+}
+
+} // namespace alg
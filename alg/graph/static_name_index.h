@@ -0,0 +1,136 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace alg {
+
+/**
+ * @brief Build-once minimal perfect hash from names to their positions
+ *
+ * BBHash layout: level l hashes the keys left over from level l - 1 into a
+ * bit array of about 2x their count and keeps the keys that landed alone.
+ * A key's slot is the rank of its bit over all levels, about 3.5 bits per
+ * key plus a rank word per 64 bits. Slots hold the id and the name, so a
+ * name that was never added is rejected by one string compare.
+ *
+ * Everything lives in one blob, Data() and Size(), that View can use in
+ * place, e.g. straight from a mapped file, so a process can start with the
+ * index already built. The blob must be 8-byte aligned.
+ */
+class PerfectNameHash {
+public:
+    PerfectNameHash() = default;
+    PerfectNameHash(PerfectNameHash&&) = default;
+    PerfectNameHash& operator=(PerfectNameHash&&) = default;
+    PerfectNameHash(const PerfectNameHash&) = delete;
+    PerfectNameHash& operator=(const PerfectNameHash&) = delete;
+
+    /**
+     * @brief Index names, names[i] gets id i; false if two names are equal
+     */
+    bool Build(const std::vector<std::string>& names);
+
+    /**
+     * @brief Use a blob made by Build without copying, it must outlive this
+     */
+    bool View(const void* blob, std::size_t size);
+
+    /**
+     * @brief Id of name, -1 if absent
+     */
+    int IndexByName(const char* name) const;
+
+    int Count() const {
+        return n;
+    }
+
+    const char* Data() const {
+        return data;
+    }
+    std::size_t Size() const {
+        return size;
+    }
+
+private:
+    struct Header;
+
+    bool Attach(const char* blob, std::size_t bytes);
+
+private:
+    std::vector<std::uint64_t> owned;
+    const char* data = nullptr;
+    std::size_t size = 0;
+
+    int n = 0;
+    int levels = 0;
+    const std::uint64_t* level_begin = nullptr;
+    const std::uint64_t* bits = nullptr;
+    const std::uint32_t* ranks = nullptr;
+    const std::int32_t* ids = nullptr;
+    const std::uint64_t* name_at = nullptr;
+    const char* chars = nullptr;
+};
+
+/**
+ * @brief Build-once double-array trie over names
+ *
+ * Node s moves on byte c to t = base[s] + c + 1 if check[t] == s, and the
+ * end of a name is the cell base[s] holding -(id + 1). A lookup is one
+ * pair of array reads per byte. Like PerfectNameHash the arrays form one
+ * blob that View uses in place.
+ */
+class DoubleArrayTrie {
+public:
+    DoubleArrayTrie() = default;
+    DoubleArrayTrie(DoubleArrayTrie&&) = default;
+    DoubleArrayTrie& operator=(DoubleArrayTrie&&) = default;
+    DoubleArrayTrie(const DoubleArrayTrie&) = delete;
+    DoubleArrayTrie& operator=(const DoubleArrayTrie&) = delete;
+
+    /**
+     * @brief Index names, names[i] gets id i; false if two names are equal
+     */
+    bool Build(const std::vector<std::string>& names);
+
+    bool View(const void* blob, std::size_t size);
+
+    int IndexByName(const char* name) const;
+
+    /**
+     * @brief Ids of all names starting with prefix, in name order
+     */
+    void WithPrefix(const char* prefix, std::vector<int>& result) const;
+
+    int Count() const {
+        return n;
+    }
+
+    const char* Data() const {
+        return data;
+    }
+    std::size_t Size() const {
+        return size;
+    }
+
+private:
+    struct Header;
+
+    bool Attach(const char* blob, std::size_t bytes);
+
+    // node reached by prefix, -1 if none
+    std::int32_t Walk(const char* prefix) const;
+
+private:
+    std::vector<std::uint64_t> owned;
+    const char* data = nullptr;
+    std::size_t size = 0;
+
+    int n = 0;
+    std::int64_t cells = 0;
+    const std::int32_t* base = nullptr;
+    const std::int32_t* check = nullptr;
+};
+
+} // namespace alg
@@ -0,0 +1,146 @@
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "alg/common/thread_pool.h"
+#include "analytics.h"
+#include "generator.h"
+
+using namespace alg;
+
+namespace {
+// plain push-style power iteration for a fixed number of rounds
+std::vector<double> SimplePageRank(const CsrGraph& g, double damping, int rounds) {
+    std::vector<double> rank(g.V, 1.0 / g.V);
+    for (int r = 0; r < rounds; r++) {
+        std::vector<double> next(g.V, (1 - damping) / g.V);
+        for (int u = 0; u < g.V; u++) {
+            if (g.Deg(u) == 0) {
+                for (double& x : next) {
+                    x += damping * rank[u] / g.V;
+                }
+            }
+            for (int v : g.Adj(u)) {
+                next[v] += damping * rank[u] / g.Deg(u);
+            }
+        }
+        rank = next;
+    }
+    return rank;
+}
+
+std::int64_t BruteTriangles(const CsrGraph& g) {
+    std::int64_t count = 0;
+    for (int a = 0; a < g.V; a++) {
+        for (int b : g.Adj(a)) {
+            if (b <= a)
+                continue;
+            for (int c : g.Adj(b)) {
+                const auto row = g.Adj(a);
+                if (c > b && std::binary_search(row.begin(), row.end(), c))
+                    count++;
+            }
+        }
+    }
+    return count;
+}
+
+// repeatedly removes a vertex of least remaining degree
+std::vector<int> BruteCores(const CsrGraph& g) {
+    std::vector<int> deg(g.V), core(g.V, -1);
+    for (int u = 0; u < g.V; u++) {
+        deg[u] = g.Deg(u) - static_cast<int>(std::count(g.Adj(u).begin(), g.Adj(u).end(), u));
+    }
+    int k = 0;
+    for (int round = 0; round < g.V; round++) {
+        int best = -1;
+        for (int u = 0; u < g.V; u++) {
+            if (core[u] == -1 && (best == -1 || deg[u] < deg[best]))
+                best = u;
+        }
+        k = std::max(k, deg[best]);
+        core[best] = k;
+        for (int w : g.Adj(best)) {
+            if (core[w] == -1 && w != best)
+                deg[w]--;
+        }
+    }
+    return core;
+}
+
+double L1(const std::vector<double>& a, const std::vector<double>& b) {
+    double sum = 0;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        sum += std::fabs(a[i] - b[i]);
+    }
+    return sum;
+}
+} // namespace
+
+int main() {
+    ThreadPool pool(4);
+    const CsrGraph rmat(1 << 10, RMatEdges(10, 8, 3));
+    const CsrGraph directed(1 << 10, RMatEdges(10, 8, 4), true);
+
+    // pagerank against push-style iteration, with and without dangling vertices
+    for (const CsrGraph* g : {&rmat, &directed}) {
+        std::vector<double> rank, parallel;
+        const int rounds = PageRank(*g, rank, nullptr, 0.85, 1e-12, 200);
+        assert(rounds > 5 && rounds < 200);
+        assert(std::fabs(std::accumulate(rank.begin(), rank.end(), 0.0) - 1) < 1e-9);
+        assert(L1(rank, SimplePageRank(*g, 0.85, rounds)) < 1e-9);
+        assert(PageRank(*g, parallel, &pool, 0.85, 1e-12, 200) == rounds);
+        assert(L1(rank, parallel) < 1e-12);
+    }
+    {
+        // star: the center takes the most, leaves are equal
+        std::vector<Edge> edges;
+        for (int v = 1; v < 10; v++) {
+            edges.push_back(Edge(0, v));
+        }
+        std::vector<double> rank;
+        assert(PageRank(CsrGraph(10, edges), rank, nullptr, 0.85, 1e-9, 3) == 3);
+        assert(rank[0] > 0.3 && std::fabs(rank[1] - rank[9]) < 1e-15);
+        assert(PageRank(CsrGraph(), rank) == 0 && rank.empty());
+    }
+
+    // triangles against brute force, skewed and uniform degrees
+    {
+        assert(CountTriangles(rmat) == BruteTriangles(rmat));
+        assert(CountTriangles(rmat, &pool) == BruteTriangles(rmat));
+        const CsrGraph gnp(2000, GnpEdges(2000, 0.02, 5));
+        assert(CountTriangles(gnp, &pool) == BruteTriangles(gnp));
+
+        // K5 with a self loop and a pendant vertex
+        std::vector<Edge> edges{Edge(2, 2), Edge(4, 5)};
+        for (int u = 0; u < 5; u++) {
+            for (int v = u + 1; v < 5; v++) {
+                edges.push_back(Edge(u, v));
+            }
+        }
+        assert(CountTriangles(CsrGraph(6, edges)) == 10);
+        assert(CountTriangles(CsrGraph()) == 0);
+    }
+
+    // core numbers against sequential peeling
+    {
+        const std::vector<int> cores = BruteCores(rmat);
+        assert(CoreNumbers(rmat) == cores);
+        assert(CoreNumbers(rmat, &pool) == cores);
+        assert(*std::max_element(cores.begin(), cores.end()) > 5);
+        const CsrGraph grid(400, GridEdges(20, 20, 0.7, 2));
+        assert(CoreNumbers(grid, &pool) == BruteCores(grid));
+
+        std::vector<Edge> edges{Edge(2, 2), Edge(4, 5), Edge(5, 6)};
+        for (int u = 0; u < 5; u++) {
+            for (int v = u + 1; v < 5; v++) {
+                edges.push_back(Edge(u, v));
+            }
+        }
+        assert(CoreNumbers(CsrGraph(8, edges)) == std::vector<int>({4, 4, 4, 4, 4, 1, 1, 0}));
+    }
+    std::cout << "Success" << std::endl;
+}
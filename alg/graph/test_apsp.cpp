@@ -0,0 +1,95 @@
+#include <cassert>
+#include <iostream>
+#include <random>
+
+#include "alg/common/thread_pool.h"
+#include "apsp.h"
+#include "instance.h"
+
+using namespace alg;
+
+namespace {
+std::vector<std::vector<double>> Naive(const std::vector<std::vector<double>>& adj) {
+    const int V = adj.size();
+    auto d = adj;
+    for (int i = 0; i < V; i++) {
+        if (d[i][i] > 0)
+            d[i][i] = 0;
+    }
+    for (int k = 0; k < V; k++) {
+        for (int i = 0; i < V; i++) {
+            for (int j = 0; j < V; j++) {
+                if (d[i][k] + d[k][j] < d[i][j])
+                    d[i][j] = d[i][k] + d[k][j];
+            }
+        }
+    }
+    return d;
+}
+
+DirectedWeightedGraph RandomGraph(int n, double p, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> coin(0, 1);
+    std::uniform_int_distribution<int> weight(1, 50);
+    DirectedWeightedGraph g(n);
+    for (int u = 0; u < n; u++) {
+        for (int v = 0; v < n; v++) {
+            if (u != v && coin(gen) < p)
+                g.AddEdge(u, v, weight(gen));
+        }
+    }
+    return g;
+}
+
+template <typename G>
+void Check(const G& g, ThreadPool& pool) {
+    const auto expected = Naive(g.adj);
+    APSP apsp(g);
+    apsp.Run(false, &pool);
+    for (int u = 0; u < g.V; u++) {
+        for (int v = 0; v < g.V; v++) {
+            assert(apsp.Dist(u, v) == expected[u][v]);
+        }
+    }
+    assert(!apsp.NegativeCycle());
+
+    std::vector<int> path;
+    assert(!apsp.Path(0, 0, path));
+    apsp.Run(true);
+    for (int u = 0; u < g.V; u++) {
+        for (int v = 0; v < g.V; v++) {
+            assert(apsp.Dist(u, v) == expected[u][v]);
+            assert(apsp.Path(u, v, path) == !IsInf(expected[u][v]));
+            if (path.empty())
+                continue;
+            assert(path.front() == u && path.back() == v);
+            double len = 0;
+            for (std::size_t i = 0; i + 1 < path.size(); i++) {
+                len += g.adj[path[i]][path[i + 1]];
+            }
+            assert(len == expected[u][v]);
+        }
+    }
+}
+} // namespace
+
+int main() {
+    ThreadPool pool(4);
+
+    Check(WeightedGraph_1(), pool);
+    Check(RandomGraph(1, 0, 1), pool);
+    Check(RandomGraph(64, 0.1, 2), pool);
+    Check(RandomGraph(150, 0.03, 3), pool);
+    Check(RandomGraph(200, 0.01, 4), pool);
+
+    DirectedWeightedGraph cycle(3);
+    cycle.AddEdge(0, 1, 1);
+    cycle.AddEdge(1, 2, -3);
+    cycle.AddEdge(2, 0, 1);
+    APSP negative(cycle);
+    negative.Run();
+    assert(negative.NegativeCycle());
+
+    std::cout << "Success" << std::endl;
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <set>
+
+#include "bcc.h"
+#include "instance.h"
+
+using namespace alg;
+
+namespace {
+// components of g without vertex x and edge (a, b)
+int Components(const CsrGraph& g, int x, int a, int b) {
+    std::vector<int> cc(g.V, -1);
+    int n = 0;
+    for (int s = 0; s < g.V; s++) {
+        if (s == x || cc[s] != -1)
+            continue;
+        std::vector<int> st = {s};
+        cc[s] = n;
+        while (!st.empty()) {
+            int u = st.back();
+            st.pop_back();
+            for (int w : g.Adj(u)) {
+                if (w == x || cc[w] != -1 || (u == a && w == b) || (u == b && w == a))
+                    continue;
+                cc[w] = n;
+                st.push_back(w);
+            }
+        }
+        n++;
+    }
+    return n;
+}
+
+void Check(const CsrGraph& g) {
+    DFS dfs(g.V);
+    BCC bcc(g);
+    bcc.Run(dfs);
+
+    const int base = Components(g, -1, -1, -1);
+    std::vector<int> separations;
+    for (int x = 0; x < g.V; x++) {
+        // removing x drops its own component if x is isolated
+        int isolated = g.Deg(x) == 0 ? 1 : 0;
+        if (Components(g, x, -1, -1) > base - isolated)
+            separations.push_back(x);
+    }
+    assert(separations == bcc.separations);
+
+    std::set<std::pair<int, int>> bridges;
+    for (const auto& e : g.Edges()) {
+        if (e.u != e.v && Components(g, -1, e.u, e.v) > base)
+            bridges.insert(std::make_pair(e.u, e.v));
+    }
+    assert(bridges.size() == bcc.bridges.size());
+    for (const auto& e : bcc.bridges) {
+        assert(bridges.count(std::minmax(e.u, e.v)));
+    }
+
+    // blocks partition the edges, and no block has a separation vertex of its own
+    std::set<std::pair<int, int>> seen;
+    for (int b = 0; b < bcc.Blocks(); b++) {
+        std::vector<Edge> block(bcc.Block(b).begin(), bcc.Block(b).end());
+        std::set<int> vertices;
+        for (const auto& e : block) {
+            assert(seen.insert(std::minmax(e.u, e.v)).second);
+            vertices.insert(e.u);
+            vertices.insert(e.v);
+        }
+        CsrGraph sub(g.V, block);
+        for (int x : vertices) {
+            // vertices outside the block stay isolated, the rest stays one piece
+            int expected = g.V - static_cast<int>(vertices.size()) + 1;
+            assert(vertices.size() <= 2 || Components(sub, x, -1, -1) == expected);
+        }
+    }
+    std::size_t loops = 0;
+    for (const auto& e : g.Edges()) {
+        loops += e.u == e.v;
+    }
+    assert(seen.size() + loops == static_cast<std::size_t>(g.E));
+}
+} // namespace
+
+int main() {
+    // instance
+    {
+        CsrGraph g(Graph_7());
+        DFS dfs(g.V);
+        BCC bcc(g);
+        bcc.Run(dfs);
+        assert(bcc.separations == std::vector<int>({0, 4, 5, 6, 7, 11}));
+        assert(bcc.bridges.size() == 3);
+        assert(bcc.Blocks() == 7);
+        Check(g);
+    }
+    for (const auto& graph : {Graph_1(), Graph_4(), Graph_5(), Graph_6()}) {
+        Check(CsrGraph(graph));
+    }
+
+    // random sparse graphs
+    std::mt19937 gen(5);
+    for (int round = 0; round < 300; round++) {
+        int n = 2 + round % 15;
+        std::uniform_int_distribution<int> vertex(0, n - 1);
+        std::vector<Edge> edges;
+        for (int i = 0; i < n + round % 7; i++) {
+            edges.push_back(Edge(vertex(gen), vertex(gen)));
+        }
+        Check(CsrGraph(n, edges));
+    }
+
+    // deep path with a cycle at the end
+    {
+        const int n = 2000000;
+        std::vector<Edge> edges;
+        for (int i = 0; i + 1 < n; i++) {
+            edges.push_back(Edge(i, i + 1));
+        }
+        edges.push_back(Edge(n - 1, n - 3));
+        CsrGraph g(n, edges);
+        DFS dfs(n);
+        BCC bcc(g);
+        bcc.Run(dfs);
+        assert(static_cast<int>(bcc.bridges.size()) == n - 3);
+        assert(static_cast<int>(bcc.separations.size()) == n - 3);
+        assert(bcc.Blocks() == n - 2);
+    }
+
+    std::cout << "Success" << std::endl;
+}
@@ -0,0 +1,104 @@
+#include <cassert>
+#include <queue>
+#include <random>
+
+#include "search.h"
+#include "instance.h"
+
+using namespace alg;
+
+namespace {
+std::vector<int> ReferenceDist(const CsrGraph& g, int s) {
+    std::vector<int> dist(g.V, -1);
+    std::queue<int> q;
+    dist[s] = 0;
+    q.push(s);
+    while (!q.empty()) {
+        int u = Qpop(q);
+        for (int v : g.Adj(u)) {
+            if (dist[v] == -1) {
+                dist[v] = dist[u] + 1;
+                q.push(v);
+            }
+        }
+    }
+    return dist;
+}
+
+void AssertValid(const CsrGraph& g, const BFS& bfs, int s) {
+    assert(bfs.dist == ReferenceDist(g, s));
+    for (int v = 0; v < g.V; v++) {
+        if (v == s || bfs.dist[v] == -1)
+            continue;
+        int p = bfs.st[v];
+        assert(bfs.dist[p] == bfs.dist[v] - 1);
+        const auto nodes = g.Adj(p);
+        assert(std::binary_search(nodes.begin(), nodes.end(), v));
+    }
+}
+
+CsrGraph RandomGraph(int n, int m, bool directed, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(0, n - 1);
+    std::vector<Edge> edges;
+    for (int i = 0; i < m; i++) {
+        edges.push_back(Edge(dist(gen), dist(gen)));
+    }
+    return CsrGraph(n, edges, directed);
+}
+} // namespace
+
+int main() {
+    // small instance
+    {
+        CsrGraph g(Graph_5());
+        BFS bfs(g.V);
+        bfs.Run(g, 0);
+        AssertValid(g, bfs, 0);
+        assert(!bfs.Reachable(7));
+        std::vector<int> p;
+        assert(bfs.PathTo(4, p));
+        assert(p.size() == 3);
+    }
+
+    ThreadPool pool(4);
+
+    // dense enough to take bottom-up steps, sequential and parallel
+    {
+        CsrGraph g = RandomGraph(100000, 800000, false, 1);
+        BFS bfs(g.V);
+        for (int s : {0, 17, 99999}) {
+            bfs.Run(g, s);
+            AssertValid(g, bfs, s);
+            assert(bfs.bottom_up_levels > 0);
+            bfs.Run(g, s, &pool);
+            AssertValid(g, bfs, s);
+            assert(bfs.bottom_up_levels > 0);
+        }
+    }
+
+    // directed graphs stay top-down
+    {
+        CsrGraph g = RandomGraph(50000, 200000, true, 2);
+        BFS bfs(g.V);
+        bfs.Run(g, 3, &pool);
+        AssertValid(g, bfs, 3);
+        assert(bfs.bottom_up_levels == 0);
+    }
+
+    // long path
+    {
+        const int n = 300000;
+        std::vector<Edge> edges;
+        for (int i = 0; i + 1 < n; i++) {
+            edges.push_back(Edge(i, i + 1));
+        }
+        CsrGraph g(n, edges);
+        BFS bfs(n);
+        bfs.Run(g, 0, &pool);
+        assert(bfs.dist[n - 1] == n - 1);
+        assert(bfs.levels == n);
+    }
+
+    std::cout << "Success" << std::endl;
+}
@@ -0,0 +1,104 @@
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "alg/common/thread_pool.h"
+#include "bit_graph.h"
+#include "search.h"
+
+using namespace alg;
+
+namespace {
+Graph RandomGraph(int n, double p, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::bernoulli_distribution coin(p);
+    Graph g(n);
+    for (int u = 0; u < n; u++) {
+        for (int v = u + 1; v < n; v++) {
+            if (coin(gen))
+                g.AddEdge(u, v);
+        }
+    }
+    return g;
+}
+
+std::int64_t BruteTriangles(const Graph& g) {
+    std::int64_t count = 0;
+    for (int a = 0; a < g.V; a++) {
+        for (int b = a + 1; b < g.V; b++) {
+            for (int c = b + 1; c < g.V; c++) {
+                count += g.adj[a][b] && g.adj[b][c] && g.adj[a][c];
+            }
+        }
+    }
+    return count;
+}
+} // namespace
+
+int main() {
+    ThreadPool pool(4);
+
+    // small sizes and one spanning several words
+    for (int n : {1, 2, 63, 64, 65, 200}) {
+        const Graph g = RandomGraph(n, 0.3, n);
+        const BitGraph b(g);
+        assert(b.V == n && b.E == g.E && !b.directed && b.Words() % 8 == 0);
+        for (int u = 0; u < n; u++) {
+            assert(b.Adj(u) == g.Adj(u) && b.Deg(u) == g.Deg(u));
+        }
+
+        const CsrGraph csr(g);
+        BFS bfs(n);
+        bfs.Run(csr, 0);
+        std::vector<int> dist;
+        BitBFS(b, 0, dist);
+        assert(dist == bfs.dist);
+
+        const std::int64_t triangles = BruteTriangles(g);
+        assert(CountTriangles(b) == triangles && CountTriangles(b, &pool) == triangles);
+        assert(BitGraph(csr).E == g.E && CountTriangles(BitGraph(csr)) == triangles);
+    }
+
+    // edge updates only count real changes
+    {
+        BitGraph b(100);
+        b.AddEdge(3, 70);
+        b.AddEdge(70, 3);
+        assert(b.E == 1 && b.HasEdge(70, 3) && b.Deg(3) == 1);
+        b.RemoveEdge(3, 70);
+        b.RemoveEdge(3, 70);
+        assert(b.E == 0 && !b.HasEdge(3, 70) && b.Adj(70).empty());
+
+        BitGraph d(100, true);
+        d.AddEdge(3, 70);
+        assert(d.E == 1 && d.HasEdge(3, 70) && !d.HasEdge(70, 3));
+    }
+
+    // cliques across word boundaries
+    {
+        const std::vector<int> clique = {1, 62, 63, 64, 130};
+        BitGraph b(150);
+        for (int u : clique) {
+            for (int v : clique) {
+                if (u < v)
+                    b.AddEdge(u, v);
+            }
+        }
+        b.AddEdge(1, 2);
+        assert(IsClique(b, clique) && IsClique(b, {}) && IsClique(b, {7}));
+        assert(IsClique(b, {1, 2}) && !IsClique(b, {1, 2, 62}));
+        assert(CountTriangles(b) == 10);
+
+        BitGraph d(150, true);
+        d.AddEdge(1, 64);
+        assert(!IsClique(d, {1, 64}));
+        d.AddEdge(64, 1);
+        assert(IsClique(d, {1, 64}));
+
+        std::vector<int> dist;
+        BitBFS(b, 2, dist);
+        assert(dist[2] == 0 && dist[1] == 1 && dist[130] == 2 && dist[7] == -1);
+    }
+    std::cout << "Success" << std::endl;
+}
@@ -0,0 +1,90 @@
+#include <cassert>
+#include <random>
+
+#include "components.h"
+#include "path.h"
+#include "instance.h"
+
+using namespace alg;
+
+namespace {
+std::vector<Edge> RandomEdges(int n, int m, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    std::vector<Edge> edges;
+    for (int i = 0; i < m; i++) {
+        edges.push_back(Edge(vertex(gen), vertex(gen)));
+    }
+    return edges;
+}
+
+void AssertGrouped(const Components& c) {
+    for (int id = 0; id < c.Count(); id++) {
+        const auto nodes = c.Members(id);
+        assert(!nodes.empty());
+        assert(std::is_sorted(nodes.begin(), nodes.end()));
+        for (int u : nodes) {
+            assert(c.cc[u] == id);
+        }
+    }
+}
+} // namespace
+
+int main() {
+    ThreadPool pool(4);
+
+    // same labels as the DFS labelling
+    for (const auto& graph : {Graph_1(), Graph_5(), Graph_6(), Graph_7()}) {
+        Path path(graph);
+        DFS dfs(graph.V);
+        path.DfsCC(dfs);
+
+        CsrGraph g(graph);
+        const auto edges = graph.Edges();
+        UnionFind uf(graph.V);
+        for (const auto& e : edges) {
+            uf.AddEdge(e);
+        }
+        assert(ConnectedComponents(uf).cc == dfs.cc);
+        assert(ConnectedComponents(graph.V, edges).cc == dfs.cc);
+        assert(ConnectedComponents(graph.V, edges, &pool).cc == dfs.cc);
+        assert(ConnectedComponents(g).cc == dfs.cc);
+        assert(ConnectedComponents(g, &pool).cc == dfs.cc);
+        AssertGrouped(ConnectedComponents(g, &pool));
+    }
+    {
+        const auto& graph = Graph_5();
+        Components c = ConnectedComponents(CsrGraph(graph));
+        assert(c.Count() == 3);
+        c.Show();
+    }
+
+    // incremental
+    {
+        UnionFind uf(5);
+        assert(uf.Count() == 5);
+        assert(uf.AddEdge(0, 1));
+        assert(uf.AddEdge(3, 4));
+        assert(!uf.AddEdge(1, 0));
+        assert(uf.Count() == 3);
+        assert(uf.Connected(4, 3) && !uf.Connected(0, 4));
+        assert(uf.AddEdge(1, 3));
+        assert(uf.Count() == 2);
+    }
+
+    // large random graphs, all modes agree
+    for (int m : {300000, 600000, 2000000}) {
+        const int n = 500000;
+        const auto edges = RandomEdges(n, m, m);
+        CsrGraph g(n, edges);
+        Path path(g);
+        DFS dfs(n);
+        path.DfsCC(dfs);
+        assert(ConnectedComponents(n, edges, &pool).cc == dfs.cc);
+        Components c = ConnectedComponents(g, &pool);
+        assert(c.cc == dfs.cc);
+        AssertGrouped(c);
+    }
+
+    std::cout << "Success" << std::endl;
+}
@@ -0,0 +1,62 @@
+#include <cassert>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "alg/common/thread_pool.h"
+#include "concurrent_name_index.h"
+
+using namespace alg;
+
+int main() {
+    ThreadPool pool(4);
+
+    // every name is interned by several threads at once
+    const int distinct = 20000;
+    std::vector<std::string> names;
+    for (int i = 0; i < distinct; i++) {
+        names.push_back("vertex-" + std::to_string(i * 7919 % 100003));
+    }
+    ConcurrentNameIndex index;
+    std::vector<int> ids(4 * distinct);
+    pool.ParallelFor(ids.size(), 257, [&](std::int64_t b, std::int64_t e, int) {
+        for (std::int64_t i = b; i < e; i++) {
+            ids[i] = index.IndexByName(names[i % distinct].c_str());
+        }
+    });
+    assert(index.Count() == distinct);
+
+    // dense and stable
+    std::vector<int> seen(distinct, 0);
+    for (int i = 0; i < distinct; i++) {
+        assert(ids[i] >= 0 && ids[i] < distinct);
+        seen[ids[i]]++;
+        for (int k = 1; k < 4; k++) {
+            assert(ids[i + k * distinct] == ids[i]);
+        }
+        assert(index.Find(names[i].c_str()) == ids[i]);
+        assert(index.IndexByName(names[i].c_str()) == ids[i]);
+    }
+    assert(std::count(seen.begin(), seen.end(), 1) == distinct);
+    assert(index.Find("missing") == -1);
+
+    for (ThreadPool* p : {static_cast<ThreadPool*>(nullptr), &pool}) {
+        const FrozenNameIndex frozen = index.Freeze(p);
+        assert(frozen.Count() == distinct);
+        for (int i = 0; i < distinct; i++) {
+            assert(frozen.Find(names[i].c_str()) == ids[i]);
+            assert(frozen.Name(ids[i]) == names[i]);
+        }
+        assert(frozen.Find("missing") == -1 && frozen.Find("") == -1);
+    }
+
+    ConcurrentNameIndex small(1);
+    assert(small.IndexByName("a") == 0 && small.IndexByName("") == 1 && small.IndexByName("a") == 0);
+    const FrozenNameIndex frozen = small.Freeze();
+    assert(frozen.Find("") == 1 && frozen.Find("a") == 0 && frozen.Find("b") == -1);
+    assert(FrozenNameIndex().Find("a") == -1);
+
+    std::cout << "Success" << std::endl;
+    return 0;
+}
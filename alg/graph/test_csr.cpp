@@ -0,0 +1,139 @@
+#include <cassert>
+#include <algorithm>
+#include <iostream>
+
+#include "csr.h"
+#include "weighted_csr.h"
+#include "instance.h"
+
+using namespace alg;
+
+namespace {
+template <typename DenseGraph>
+void AssertSameAdj(const DenseGraph& g, const CsrGraph& csr) {
+    assert(g.V == csr.V);
+    for (int u = 0; u < g.V; u++) {
+        const auto dense = g.Adj(u);
+        const auto sparse = csr.Adj(u);
+        assert(dense.size() == sparse.size());
+        assert(std::equal(dense.begin(), dense.end(), sparse.begin()));
+    }
+}
+} // namespace
+
+int main() {
+    // dense -> csr
+    {
+        const auto& graph = Graph_7();
+        CsrGraph csr(graph);
+        AssertSameAdj(graph, csr);
+        assert(csr.E == graph.E);
+        assert(csr.Edges().size() == static_cast<std::size_t>(graph.E));
+    }
+
+    // edge list -> csr, duplicates are dropped
+    {
+        const auto& graph = Graph_5();
+        auto edges = graph.Edges();
+        edges.push_back(Edge(4, 3));
+        edges.push_back(Edge(0, 1));
+        CsrGraph csr(graph.V, edges);
+        AssertSameAdj(graph, csr);
+        assert(csr.E == graph.E);
+    }
+
+    // directed
+    {
+        DirectedGraph graph(4);
+        graph.AddEdge(0, 1);
+        graph.AddEdge(1, 2);
+        graph.AddEdge(2, 0);
+        graph.AddEdge(2, 3);
+        CsrGraph csr(graph);
+        AssertSameAdj(graph, csr);
+        assert(csr.directed);
+        assert(csr.E == 4);
+        assert(csr.Deg(3) == 0);
+    }
+
+    // self loop is stored once
+    {
+        CsrGraph csr(3, {Edge(0, 0), Edge(0, 1), Edge(1, 2)});
+        assert(csr.E == 3);
+        assert(csr.Deg(0) == 2);
+        assert(csr.Deg(1) == 2);
+    }
+
+    // views share the rows, Topology copies them back
+    {
+        const CsrGraph csr(Graph_1());
+        const GraphView view = csr;
+        assert(view.V == csr.V && view.E == csr.E && !view.directed);
+        assert(view.Adj(1).begin() == csr.Adj(1).begin() && view.Deg(2) == csr.Deg(2));
+        const CsrGraph copy = view.Topology();
+        assert(copy.offsets == csr.offsets && copy.neighbors == csr.neighbors && copy.E == csr.E);
+        assert(GraphView().V == 0 && GraphView().Topology().offsets.size() == 1);
+
+        const WeightedCsrGraphF64 weighted(WeightedGraph_1());
+        const WeightedGraphView<double> wview = weighted;
+        assert(wview.Weights(0).begin() == weighted.Weights(0).begin());
+        assert(weighted.View().Adj(3).begin() == weighted.Targets(3).begin());
+        double sum = 0;
+        for (const auto& arc : wview.Edges(0)) {
+            sum += arc.w;
+        }
+        for (double w : weighted.Weights(0)) {
+            sum -= w;
+        }
+        assert(sum == 0);
+    }
+
+    // dense graphs count duplicate and missing edges once
+    {
+        Graph graph(4);
+        graph.AddEdge(0, 1);
+        graph.AddEdge(1, 0);
+        graph.RemoveEdge(2, 3);
+        assert(graph.E == 1 && CsrGraph(graph).E == 1);
+        graph.RemoveEdge(1, 0);
+        graph.RemoveEdge(0, 1);
+        assert(graph.E == 0);
+
+        DirectedGraph directed(4);
+        directed.AddEdge(0, 1);
+        directed.AddEdge(0, 1);
+        directed.AddEdge(1, 0);
+        directed.RemoveEdge(2, 3);
+        assert(directed.E == 2 && CsrGraph(directed).E == 2);
+
+        WeightedGraph weighted(4);
+        weighted.AddEdge(0, 1, 2.0);
+        weighted.AddEdge(1, 0, 5.0);
+        weighted.RemoveEdge(2, 3);
+        assert(weighted.E == 1 && weighted.adj[0][1] == 5.0);
+        weighted.RemoveEdge(0, 1);
+        weighted.RemoveEdge(0, 1);
+        assert(weighted.E == 0);
+
+        DirectedWeightedGraph directed_weighted(4);
+        directed_weighted.AddEdge(0, 1, 2.0);
+        directed_weighted.AddEdge(0, 1, 3.0);
+        directed_weighted.RemoveEdge(1, 0);
+        assert(directed_weighted.E == 1 && directed_weighted.adj[0][1] == 3.0);
+    }
+
+    // large path-like graph
+    {
+        const int n = 1000000;
+        std::vector<Edge> edges;
+        for (int i = 0; i + 1 < n; i++) {
+            edges.push_back(Edge(i + 1, i));
+        }
+        CsrGraph csr(n, edges);
+        assert(csr.E == n - 1);
+        assert(csr.Deg(0) == 1 && csr.Deg(n - 1) == 1 && csr.Deg(n / 2) == 2);
+        assert(csr.Adj(n / 2)[0] == n / 2 - 1);
+    }
+
+    std::cout << "Success" << std::endl;
+}
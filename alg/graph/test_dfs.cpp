@@ -0,0 +1,147 @@
+#include <cassert>
+
+#include "path.h"
+#include "instance.h"
+
+using namespace alg;
+
+namespace {
+bool SameState(const DFS& a, const DFS& b) {
+    return a.st == b.st && a.pre == b.pre && a.cc == b.cc && a.color2 == b.color2 && a.low == b.low;
+}
+
+bool SameEdges(const std::vector<LinkEdge>& a, const std::vector<LinkEdge>& b) {
+    if (a.size() != b.size())
+        return false;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        if (a[i].e.u != b[i].e.u || a[i].e.v != b[i].e.v || a[i].l != b[i].l)
+            return false;
+    }
+    return true;
+}
+
+bool SameEdges(const std::vector<Edge>& a, const std::vector<Edge>& b) {
+    if (a.size() != b.size())
+        return false;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        if (a[i].u != b[i].u || a[i].v != b[i].v)
+            return false;
+    }
+    return true;
+}
+
+// recursive and iterative kernels must leave identical state
+void Compare(const Graph& graph) {
+    Path path(graph);
+    const int V = graph.V;
+    for (int u = 0; u < V; u++) {
+        DFS r(V), i(V);
+        int pre_r = 0, pre_i = 0;
+        r.st[u] = i.st[u] = u;
+        r.pre[u] = pre_r++;
+        i.pre[u] = pre_i++;
+        path.DfsR(u, pre_r, r);
+        path.DfsI(u, pre_i, i);
+        assert(SameState(r, i) && pre_r == pre_i);
+    }
+    {
+        DFS r(V), i(V);
+        int id = 0;
+        for (int u = 0; u < V; u++) {
+            if (r.cc[u] == -1) {
+                path.DfsCCR(r, u, id);
+                path.DfsCCI(i, u, id);
+                id++;
+            }
+        }
+        assert(SameState(r, i));
+    }
+    {
+        DFS r(V), i(V);
+        int pre_r = 0, pre_i = 0;
+        assert(path.DfsBipartiteR(r, 0, pre_r, 0) == path.DfsBipartiteI(i, 0, pre_i, 0));
+        assert(SameState(r, i) && pre_r == pre_i);
+    }
+    for (const auto& e : graph.Edges()) {
+        {
+            DFS r(V), i(V);
+            std::vector<LinkEdge> er, ei;
+            int pre_r = 0, pre_i = 0;
+            r.pre[e.u] = pre_r++;
+            i.pre[e.u] = pre_i++;
+            path.DfsEulerR(r, e, pre_r, er);
+            path.DfsEulerI(i, e, pre_i, ei);
+            assert(SameState(r, i) && SameEdges(er, ei));
+        }
+        {
+            DFS r(V), i(V);
+            std::vector<Edge> br, bi;
+            int pre_r = 0, pre_i = 0;
+            path.DfsBridgesR(r, e, pre_r, br);
+            path.DfsBridgesI(i, e, pre_i, bi);
+            assert(SameState(r, i) && SameEdges(br, bi));
+        }
+    }
+    for (int u = 0; u < V; u++) {
+        for (int v = 0; v < V; v++) {
+            std::unordered_map<int, bool> visited;
+            std::vector<int> pr, pi;
+            bool found = path.PathDsfR(u, v, visited, pr);
+            std::reverse(pr.begin(), pr.end());
+            assert(found == path.PathDsfI(u, v, pi));
+            assert(pr == pi);
+        }
+    }
+}
+} // namespace
+
+int main() {
+    for (const auto& graph : {Graph_1(), Graph_2(), Graph_3(), Graph_4(), Graph_5(), Graph_6(), Graph_7()}) {
+        Compare(graph);
+    }
+
+    // tree layout from hand-made parent links
+    {
+        DFS dfs(5);
+        dfs.st = {0, 0, 0, 1, 4};
+        DfsTreeLayout layout(dfs.st);
+        assert((layout.ws == std::vector<int>{0, 1, 1, 2, 0}));
+        assert((layout.ds == std::vector<int>{0, 0, 1, 0, 0}));
+        assert(dfs.ToString(3) == "-0-1-3\n |\n  -2\n");
+        assert(dfs.ToString(4) == "-4\n");
+        std::ostringstream all;
+        layout.WriteAll(all);
+        assert(all.str() == dfs.ToString(0) + dfs.ToString(4));
+        assert(all.str() == dfs.ToString(2, layout) + dfs.ToString(4, layout));
+    }
+
+    // deep path-like graph, far beyond the recursion limit
+    {
+        const int n = 500000;
+        std::vector<Edge> edges;
+        for (int i = 0; i + 1 < n; i++) {
+            edges.push_back(Edge(i, i + 1));
+        }
+        edges.push_back(Edge(0, n / 2));
+        Path path(CsrGraph(n, edges));
+        DFS dfs(n);
+        path.Dfs(dfs, 0);
+        assert(dfs.pre[n - 1] == n - 1 && dfs.st[n - 1] == n - 2);
+        // one row of n six-digit vertices
+        assert(dfs.ToString(n - 1).size() == 7 * static_cast<std::size_t>(n) + 1);
+        path.DfsCC(dfs);
+        assert(*std::max_element(dfs.cc.begin(), dfs.cc.end()) == 0);
+        assert(path.DfsBipartite(dfs) == false);
+
+        DFS bdfs(n);
+        std::vector<Edge> bridges;
+        path.DfsBridges(bdfs, Edge(0, 1), bridges);
+        assert(static_cast<int>(bridges.size()) == n - 1 - n / 2);
+
+        std::vector<int> p;
+        assert(path.PathDsf(0, n - 1, p));
+        assert(p.front() == 0 && p.back() == n - 1);
+    }
+
+    std::cout << "Success" << std::endl;
+}
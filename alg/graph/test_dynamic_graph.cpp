@@ -0,0 +1,172 @@
+#include <cassert>
+#include <climits>
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "alg/common/thread_pool.h"
+#include "dynamic_graph.h"
+#include "generator.h"
+#include "search.h"
+
+using namespace alg;
+
+namespace {
+// edge set kept by the test, u <= v unless directed
+struct Model {
+    void Apply(const std::vector<EdgeUpdate>& batch) {
+        for (const auto& x : batch) {
+            std::pair<int, int> e(x.u, x.v);
+            if (!directed && e.first > e.second)
+                std::swap(e.first, e.second);
+            if (x.insert) {
+                edges.insert(e);
+                V = std::max(V, std::max(x.u, x.v) + 1);
+            } else {
+                edges.erase(e);
+            }
+        }
+    }
+
+    CsrGraph Csr() const {
+        std::vector<Edge> list;
+        for (const auto& e : edges) {
+            list.push_back(Edge(e.first, e.second));
+        }
+        return CsrGraph(V, list, directed);
+    }
+
+    int V;
+    bool directed;
+    std::set<std::pair<int, int>> edges;
+};
+
+bool SameGraph(const DynamicSnapshot& s, const CsrGraph& g) {
+    if (s.V != g.V || s.E != g.E || s.directed != g.directed)
+        return false;
+    for (int u = 0; u < g.V; u++) {
+        const auto a = s.Adj(u);
+        const auto b = g.Adj(u);
+        if (a.size() != b.size() || !std::equal(a.begin(), a.end(), b.begin()))
+            return false;
+    }
+    const CsrGraph t = s.Topology();
+    return t.offsets == g.offsets && t.neighbors == g.neighbors;
+}
+
+std::vector<EdgeUpdate> RandomBatch(std::mt19937& gen, int size, int V, double insert) {
+    std::uniform_int_distribution<int> vertex(0, V - 1);
+    std::bernoulli_distribution coin(insert);
+    std::vector<EdgeUpdate> batch;
+    for (int i = 0; i < size; i++) {
+        batch.push_back({vertex(gen), vertex(gen), coin(gen)});
+    }
+    return batch;
+}
+} // namespace
+
+int main() {
+    ThreadPool pool(4);
+
+    // duplicates, missing edges and self loops
+    {
+        DynamicGraph g(5);
+        assert(g.Insert({Edge(0, 1), Edge(1, 0), Edge(0, 1), Edge(2, 2), Edge(2, 2)}));
+        auto s = g.Read();
+        assert(s->E == 2 && s->epoch == 1 && s->Deg(0) == 1 && s->Deg(1) == 1 && s->Deg(2) == 1);
+        assert(s->HasEdge(1, 0) && s->HasEdge(2, 2) && !s->HasEdge(0, 2));
+        assert(g.Erase({Edge(3, 4), Edge(1, 0), Edge(0, 1)}));
+        s = g.Read();
+        assert(s->E == 1 && s->epoch == 2 && s->Deg(0) == 0);
+
+        // the last update of an edge in a batch wins
+        assert(g.Apply({{0, 1, true}, {1, 0, false}, {3, 4, false}, {4, 3, true}}));
+        s = g.Read();
+        assert(s->E == 2 && !s->HasEdge(0, 1) && s->HasEdge(3, 4) && s->HasEdge(4, 3));
+
+        // negative ids and INT_MAX change nothing
+        assert(!g.Apply({{0, 1, true}, {-1, 0, true}}));
+        assert(!g.Apply({{0, 1, true}, {INT_MAX, 0, true}}) && !g.Insert({Edge(2, INT_MAX)}));
+        assert(g.Read() == s && !s->HasEdge(0, 1));
+    }
+
+    // vertices are added by inserting their edges
+    {
+        DynamicGraph g;
+        assert(g.Read()->V == 0);
+        assert(g.Erase({Edge(700, 3)}));
+        assert(g.Read()->V == 0 && g.Read()->E == 0);
+        assert(g.Insert({Edge(700, 3), Edge(1000, 1000)}));
+        const auto s = g.Read();
+        assert(s->V == 1001 && s->E == 2 && s->HasEdge(3, 700) && s->Deg(999) == 0);
+        assert(s->Topology().neighbors.size() == 3);
+    }
+
+    // random batches against a rebuilt CSR, serial and parallel alike
+    for (bool directed : {false, true}) {
+        std::mt19937 gen(directed ? 11 : 7);
+        DynamicGraph serial(300, directed), parallel(300, directed);
+        Model model{300, directed, {}};
+        for (int round = 0; round < 40; round++) {
+            const int V = 300 + round * 20;
+            const auto batch = RandomBatch(gen, round % 5 == 0 ? 2000 : 100, V, round < 20 ? 0.8 : 0.4);
+            model.Apply(batch);
+            assert(serial.Apply(batch));
+            assert(parallel.Apply(batch, &pool));
+            const CsrGraph expected = model.Csr();
+            assert(SameGraph(*serial.Read(), expected));
+            assert(SameGraph(*parallel.Read(), expected));
+        }
+    }
+
+    // old snapshots stay as they were, untouched pages are shared
+    {
+        DynamicGraph g;
+        assert(g.Insert(RMatEdges(12, 4, 3)));
+        const auto before = g.Read();
+        const CsrGraph copy = before->Topology();
+        assert(g.Apply({{5, 6, true}, {5, 6, false}, {0, 7, true}}));
+        const auto after = g.Read();
+        assert(after->epoch == before->epoch + 1);
+        assert(SameGraph(*before, copy));
+        assert(after->pages[0] != before->pages[0]);
+        assert(after->pages[1] == before->pages[1]);
+        assert(after->HasEdge(7, 0) && after->E == before->E + !before->HasEdge(0, 7) - before->HasEdge(5, 6));
+    }
+
+    // readers search their snapshot while the writer keeps ingesting
+    {
+        DynamicGraph g(1 << 12);
+        assert(g.Insert(RMatEdges(12, 4, 9)));
+        std::atomic<bool> done(false);
+        std::thread reader([&] {
+            std::uint64_t seen = 0;
+            while (!done.load()) {
+                const auto s = g.Read();
+                assert(s->epoch >= seen);
+                seen = s->epoch;
+                const CsrGraph t = s->Topology();
+                BFS bfs(t.V);
+                bfs.Run(t, 0);
+                for (int u = 0; u < t.V; u++) {
+                    for (int v : t.Adj(u)) {
+                        assert(bfs.dist[u] == -1 || (bfs.dist[v] != -1 && bfs.dist[v] <= bfs.dist[u] + 1));
+                    }
+                }
+            }
+        });
+        std::mt19937 gen(5);
+        for (int round = 0; round < 50; round++) {
+            assert(g.Apply(RandomBatch(gen, 500, 1 << 12, 0.5), &pool));
+        }
+        done = true;
+        reader.join();
+        assert(g.Read()->epoch == 51);
+    }
+    std::cout << "Success" << std::endl;
+}
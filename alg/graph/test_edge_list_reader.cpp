@@ -0,0 +1,180 @@
+#include <cassert>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+#include "alg/common/thread_pool.h"
+#include "edge_list_reader.h"
+
+using namespace alg;
+
+namespace {
+std::string TempPath(const std::string& name) {
+    const char* dir = std::getenv("TEST_TMPDIR");
+    return std::string(dir ? dir : "/tmp") + "/" + name;
+}
+
+void Write(const std::string& path, const std::string& text) {
+    std::ofstream out(path);
+    out << text;
+}
+
+std::vector<Edge> RandomEdges(int n, int m, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    std::uniform_int_distribution<int> weight(-50, 50);
+    std::vector<Edge> edges;
+    for (int i = 0; i < m; i++) {
+        edges.push_back(Edge(vertex(gen), vertex(gen), weight(gen) / 4.0));
+    }
+    return edges;
+}
+
+void TestRandom(ThreadPool& pool) {
+    const std::string path = TempPath("test_edge_list_reader.txt");
+    for (int n : {50, 2000}) {
+        const auto edges = RandomEdges(n, 200000, n);
+        {
+            std::ofstream out(path);
+            out << "# header\n";
+            for (std::size_t i = 0; i < edges.size(); i++) {
+                const auto& e = edges[i];
+                out << (i % 3 ? "" : "  ") << e.u << (i % 2 ? "\t" : " ") << e.v << " " << e.w
+                    << (i % 5 ? "\n" : " \r\n");
+            }
+        }
+        int V = 0;
+        for (const auto& e : edges) {
+            V = std::max(V, std::max(e.u, e.v) + 1);
+        }
+        for (bool directed : {false, true}) {
+            const CsrGraph expected(V, edges, directed);
+            const WeightedCsrGraphF64 weighted(V, edges, directed);
+            for (ThreadPool* p : {static_cast<ThreadPool*>(nullptr), &pool}) {
+                CsrGraph g;
+                assert(ReadEdgeList(path, g, directed, p));
+                assert(g.V == V && g.E == expected.E && g.directed == directed);
+                assert(g.offsets == expected.offsets && g.neighbors == expected.neighbors);
+                assert(ReadEdgeList(path, g, directed, p, V + 5) && g.V == V + 5);
+                assert(!ReadEdgeList(path, g, directed, p, V - 1) && g.V == V + 5);
+
+                WeightedCsrGraphF64 w;
+                assert(ReadEdgeList(path, w, directed, p));
+                assert(w.E == weighted.E && w.offsets == weighted.offsets);
+                assert(w.targets == weighted.targets && w.weights == weighted.weights);
+            }
+        }
+    }
+    std::remove(path.c_str());
+}
+
+// ids of eight or more digits take the SWAR path
+void TestLarge(ThreadPool& pool) {
+    const std::string path = TempPath("test_edge_list_reader_large.txt");
+    Write(path, "123456789 987654321\n2147483647 0\n");
+    CsrGraph g;
+    assert(!ReadEdgeList(path, g, true, &pool, 1000));
+    WeightedCsrGraphI32 w;
+    Write(path, "1234567 3 7\n3 01234567 -2\n");
+    assert(ReadEdgeList(path, w, true, &pool));
+    assert(w.V == 1234568 && w.E == 2);
+    assert(w.Targets(1234567)[0] == 3 && w.Weights(3)[0] == -2);
+    Write(path, "2147483648 1\n");
+    assert(!ReadEdgeList(path, g, false, &pool));
+    std::remove(path.c_str());
+}
+
+void TestMalformed(ThreadPool& pool) {
+    const std::string path = TempPath("test_edge_list_reader_bad.txt");
+    CsrGraph g;
+    for (const char* text : {"1\n", "1 2x\n", "1 x\n", "-1 2\n", "1 2\n3"}) {
+        Write(path, text);
+        assert(!ReadEdgeList(path, g, false, &pool));
+    }
+    WeightedCsrGraphF32 w;
+    Write(path, "1 2\n");
+    assert(!ReadEdgeList(path, w, false, &pool));
+    Write(path, "");
+    assert(ReadEdgeList(path, g, false, &pool) && g.V == 0 && g.E == 0);
+    Write(path, "4 4\n% last line without newline\n1 2");
+    assert(ReadEdgeList(path, g, false, &pool) && g.V == 5 && g.E == 2);
+    assert(!ReadEdgeList(TempPath("test_edge_list_reader.missing"), g));
+    std::remove(path.c_str());
+}
+
+void TestNames() {
+    const std::string path = TempPath("test_edge_list_reader_names.txt");
+    Write(path, "# names\nparis london\nlondon berlin\r\n\n  berlin\tparis \nrome rome\n");
+    NameIndex names;
+    CsrGraph g;
+    assert(ReadEdgeList(path, names, g));
+    assert(names.Count() == 4 && g.V == 4 && g.E == 4);
+    assert(names.IndexByName("rome") == 3);
+    assert(g.Deg(0) == 2 && g.Deg(3) == 1);
+    Write(path, "a\n");
+    assert(!ReadEdgeList(path, names, g));
+
+    // weights in the third column, ignored by the unweighted reader
+    Write(path, "paris london 3 extra\nlondon berlin 2.5\nparis london 4\n");
+    NameIndex fresh;
+    assert(ReadEdgeList(path, fresh, g) && g.V == 3 && g.E == 2);
+    WeightedCsrGraphF64 wg;
+    assert(ReadEdgeList(path, fresh, wg) && wg.V == 3 && wg.E == 2);
+    assert(wg.Weights(0)[0] == 4 && wg.Weights(2)[0] == 2.5);
+    Write(path, "paris london x\n");
+    assert(ReadEdgeList(path, fresh, g) && !ReadEdgeList(path, fresh, wg));
+    Write(path, "paris london\n");
+    assert(!ReadEdgeList(path, fresh, wg));
+    std::remove(path.c_str());
+}
+
+// concurrent resolution against the sequential reader, up to renaming
+void TestConcurrentNames(ThreadPool& pool) {
+    const std::string path = TempPath("test_edge_list_reader_cnames.txt");
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<int> vertex(0, 4999);
+    std::uniform_int_distribution<int> weight(1, 100);
+    {
+        std::ofstream out(path);
+        out << "% names\n";
+        for (int i = 0; i < 100000; i++) {
+            out << "v" << vertex(gen) << "\tv" << vertex(gen) << " " << weight(gen) << "\n";
+        }
+    }
+    NameIndex sequential;
+    WeightedCsrGraphI32 expected;
+    assert(ReadEdgeList(path, sequential, expected, true));
+    for (ThreadPool* p : {static_cast<ThreadPool*>(nullptr), &pool}) {
+        ConcurrentNameIndex names;
+        WeightedCsrGraphI32 g;
+        assert(ReadEdgeList(path, names, g, true, p));
+        assert(names.Count() == sequential.Count() && g.V == expected.V && g.E == expected.E);
+        const FrozenNameIndex frozen = names.Freeze();
+        for (int u = 0; u < g.V; u++) {
+            const int x = sequential.IndexByName(frozen.Name(u));
+            assert(g.Deg(u) == expected.Deg(x));
+            for (const auto& a : g.Edges(u)) {
+                const int y = sequential.IndexByName(frozen.Name(a.v));
+                const auto t = expected.Targets(x);
+                const auto it = std::lower_bound(t.begin(), t.end(), y);
+                assert(it != t.end() && *it == y && expected.Weights(x)[it - t.begin()] == a.w);
+            }
+        }
+    }
+    std::remove(path.c_str());
+}
+} // namespace
+
+int main() {
+    ThreadPool pool(4);
+    TestRandom(pool);
+    TestLarge(pool);
+    TestMalformed(pool);
+    TestNames();
+    TestConcurrentNames(pool);
+    std::cout << "Success" << std::endl;
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <cassert>
+#include <iostream>
+#include <set>
+
+#include "euler.h"
+#include "instance.h"
+
+using namespace alg;
+
+namespace {
+// every edge of g walked exactly once
+bool IsEulerWalk(const CsrGraph& g, const std::vector<int>& path) {
+    if (static_cast<std::int64_t>(path.size()) != g.E + 1)
+        return false;
+    std::multiset<std::pair<int, int>> edges;
+    for (const auto& e : g.Edges()) {
+        edges.insert(std::make_pair(e.u, e.v));
+    }
+    for (std::size_t i = 0; i + 1 < path.size(); i++) {
+        int u = path[i], v = path[i + 1];
+        if (!g.directed && u > v)
+            std::swap(u, v);
+        auto it = edges.find(std::make_pair(u, v));
+        if (it == edges.end())
+            return false;
+        edges.erase(it);
+    }
+    return edges.empty();
+}
+} // namespace
+
+int main() {
+    // circuit
+    {
+        CsrGraph g(Graph_2());
+        Euler euler(g);
+        std::vector<int> p;
+        assert(euler.Exist(0, 0));
+        assert(euler.Circuit(0, p));
+        assert(p.front() == 0 && p.back() == 0);
+        assert(IsEulerWalk(g, p));
+    }
+
+    // path between the two odd vertices only
+    {
+        Graph dense = Graph_2();
+        dense.RemoveEdge(0, 6);
+        CsrGraph g(dense);
+        Euler euler(g);
+        std::vector<int> p;
+        assert(!euler.Exist(0, 0));
+        assert(!euler.Path(0, 4, p));
+        assert(euler.Path(0, 6, p));
+        assert(p.front() == 0 && p.back() == 6);
+        assert(IsEulerWalk(g, p));
+    }
+
+    // even degrees but two components
+    {
+        CsrGraph g(7, {Edge(0, 1), Edge(1, 2), Edge(2, 0), Edge(3, 4), Edge(4, 5), Edge(5, 3)});
+        Euler euler(g);
+        std::vector<int> p;
+        assert(euler.Exist(0, 0));
+        assert(!euler.Circuit(0, p) && p.empty());
+        // isolated start, rejected before walking
+        p.assign(3, 1);
+        assert(!euler.Circuit(6, p) && p.empty());
+    }
+
+    // odd vertices 0 and 3, but the edges are split over two components
+    {
+        CsrGraph g(6, {Edge(0, 1), Edge(1, 2), Edge(2, 0), Edge(0, 3), Edge(4, 5), Edge(5, 4)}, true);
+        Euler euler(g);
+        std::vector<int> p(5, 0);
+        assert(!euler.Path(0, 3, p) && p.empty());
+        assert(!euler.Path(3, 0, p) && p.empty());
+    }
+
+    // self loop
+    {
+        CsrGraph g(2, {Edge(0, 1), Edge(1, 1)});
+        Euler euler(g);
+        std::vector<int> p;
+        assert(euler.Path(0, 1, p));
+        assert(IsEulerWalk(g, p));
+    }
+
+    // directed
+    {
+        DirectedGraph dense(4);
+        dense.AddEdge(0, 1);
+        dense.AddEdge(1, 2);
+        dense.AddEdge(2, 0);
+        dense.AddEdge(2, 3);
+        dense.AddEdge(3, 2);
+        dense.AddEdge(0, 2);
+        CsrGraph g(dense);
+        Euler euler(g);
+        std::vector<int> p;
+        assert(!euler.Exist(2, 2));
+        assert(euler.Exist(0, 2));
+        assert(euler.Path(0, 2, p));
+        assert(IsEulerWalk(g, p));
+    }
+
+    // large circulant graph, every degree is 6
+    {
+        const int n = 300000;
+        std::vector<Edge> edges;
+        for (int i = 0; i < n; i++) {
+            for (int k = 1; k <= 3; k++) {
+                edges.push_back(Edge(i, (i + k) % n));
+            }
+        }
+        CsrGraph g(n, edges);
+        Euler euler(g);
+        std::vector<int> p;
+        assert(euler.Circuit(5, p));
+        assert(static_cast<std::int64_t>(p.size()) == 3 * n + 1);
+        assert(p.front() == 5 && p.back() == 5);
+    }
+
+    std::cout << "Success" << std::endl;
+}
@@ -0,0 +1,92 @@
+#include <cassert>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "alg/common/thread_pool.h"
+#include "csr.h"
+#include "generator.h"
+
+using namespace alg;
+
+namespace {
+bool SameEdges(const std::vector<Edge>& a, const std::vector<Edge>& b) {
+    if (a.size() != b.size())
+        return false;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        if (a[i].u != b[i].u || a[i].v != b[i].v || a[i].w != b[i].w)
+            return false;
+    }
+    return true;
+}
+} // namespace
+
+int main() {
+    ThreadPool pool(4);
+
+    // R-MAT: same edges for any pool, in range, skewed degrees
+    {
+        const auto edges = RMatEdges(12, 8, 7);
+        assert(edges.size() == 8u * 4096);
+        assert(SameEdges(edges, RMatEdges(12, 8, 7, &pool)));
+        assert(!SameEdges(edges, RMatEdges(12, 8, 8)));
+        for (const auto& e : edges) {
+            assert(e.u >= 0 && e.u < 4096 && e.v >= 0 && e.v < 4096);
+        }
+        const CsrGraph g(4096, edges);
+        int max_deg = 0;
+        for (int u = 0; u < g.V; u++) {
+            max_deg = std::max(max_deg, g.Deg(u));
+        }
+        assert(max_deg > 10 * 2 * 8);
+    }
+
+    // full and thinned grids
+    {
+        const auto full = GridEdges(5, 7, 1.0, 1);
+        assert(full.size() == 5u * 6 + 4u * 7);
+        for (const auto& e : full) {
+            assert(e.v == e.u + 1 || e.v == e.u + 7);
+        }
+        const auto road = GridEdges(100, 100, 0.5, 1);
+        assert(road.size() > 8000 && road.size() < 11800);
+        assert(SameEdges(road, GridEdges(100, 100, 0.5, 1)));
+    }
+
+    // G(n, p) against its expected edge count
+    {
+        assert(GnpEdges(50, 0.0, 1).empty());
+        assert(GnpEdges(50, 1.0, 1).size() == 50u * 49 / 2);
+        assert(GnpEdges(50, 1.0, 1, true).size() == 50u * 49);
+
+        const auto edges = GnpEdges(2000, 0.01, 3);
+        assert(edges.size() > 19000 && edges.size() < 21000);
+        for (const auto& e : edges) {
+            assert(e.w == 1.0 && e.u > e.v && e.v >= 0 && e.u < 2000);
+        }
+        assert(CsrGraph(2000, edges).E == static_cast<std::int64_t>(edges.size()));
+
+        const auto directed = GnpEdges(2000, 0.01, 3, true);
+        assert(directed.size() > 38000 && directed.size() < 42000);
+        for (const auto& e : directed) {
+            assert(e.u != e.v);
+        }
+        assert(CsrGraph(2000, directed, true).E == static_cast<std::int64_t>(directed.size()));
+    }
+
+    // weights in range and repeatable
+    {
+        auto a = GnpEdges(300, 0.1, 5), b = a;
+        RandomWeights(a, 10, 9);
+        RandomWeights(b, 10, 9);
+        assert(SameEdges(a, b));
+        bool low = false, high = false;
+        for (const auto& e : a) {
+            assert(e.w >= 1 && e.w <= 10 && e.w == static_cast<int>(e.w));
+            low |= e.w == 1;
+            high |= e.w == 10;
+        }
+        assert(low && high);
+    }
+    std::cout << "Success" << std::endl;
+}
@@ -0,0 +1,222 @@
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <unistd.h>
+
+#include "graph_file.h"
+#include "instance.h"
+#include "max_flow.h"
+#include "mst.h"
+#include "path.h"
+#include "shortest_path.h"
+
+using namespace alg;
+
+namespace {
+std::string TempPath(const std::string& name) {
+    const char* dir = std::getenv("TEST_TMPDIR");
+    return std::string(dir ? dir : "/tmp") + "/" + name;
+}
+
+// overwrites sizeof(T) bytes of the file at offset
+template <typename T>
+void Patch(const std::string& path, std::int64_t offset, T value) {
+    std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(offset);
+    f.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+GraphFileHeader ReadHeader(const std::string& path) {
+    GraphFileHeader h;
+    std::ifstream(path, std::ios::binary).read(reinterpret_cast<char*>(&h), sizeof(h));
+    return h;
+}
+
+void CheckSame(const CsrGraph& g, const MappedGraph& m) {
+    assert(m.V == g.V && m.E == g.E && m.directed == g.directed);
+    for (int u = 0; u < g.V; u++) {
+        const auto a = g.Adj(u), b = m.Adj(u);
+        assert(std::vector<int>(a.begin(), a.end()) == std::vector<int>(b.begin(), b.end()));
+    }
+}
+
+void TestCsr() {
+    const std::string path = TempPath("test_graph_file.bin");
+    for (const auto& dense : {Graph_1(), Graph_2(), Graph_5()}) {
+        const CsrGraph g(dense);
+        std::vector<std::string> names;
+        for (int u = 0; u < g.V; u++) {
+            names.push_back("v" + std::to_string(u * 7));
+        }
+        assert(WriteGraphFile(path, g, &names));
+
+        MappedGraph m;
+        assert(m.Open(path));
+        CheckSame(g, m);
+        assert(m.WeightType() == kNoWeight && m.Weights<float>(0).empty());
+        assert(m.HasNames() && std::string(m.Name(3)) == "v21");
+        NameIndex index;
+        m.LoadNames(index);
+        assert(index.Count() == g.V && index.IndexByName("v14") == 2);
+        CheckSame(g, m);
+        const CsrGraph copy = m.Topology();
+        assert(copy.offsets == g.offsets && copy.neighbors == g.neighbors);
+
+        // analyses run on the mapped rows without copying them
+        std::vector<int> a, b;
+        assert(Path(m.View()).PathDsf(0, g.V - 1, a) == Path(g).PathDsf(0, g.V - 1, b) && a == b);
+        BFS over_file(g.V), over_csr(g.V);
+        over_file.Run(m.View(), 0);
+        over_csr.Run(g, 0);
+        assert(over_file.dist == over_csr.dist);
+    }
+
+    // without names, then a truncated file
+    assert(WriteGraphFile(path, CsrGraph(Graph_3())));
+    MappedGraph m;
+    assert(m.Open(path) && !m.HasNames());
+    m.Close();
+    assert(truncate(path.c_str(), sizeof(GraphFileHeader) + 8) == 0);
+    assert(!m.Open(path) && !m.IsOpen());
+    assert(!m.Open(TempPath("test_graph_file.missing")));
+
+    // rows and names that would lead out of the mapping
+    const CsrGraph g(Graph_1());
+    const std::vector<std::string> names(g.V, "v");
+    for (int corrupt = 0; corrupt < 8; corrupt++) {
+        assert(WriteGraphFile(path, g, &names) && m.Open(path));
+        m.Close();
+        const GraphFileHeader h = ReadHeader(path);
+        if (corrupt == 0)
+            Patch<std::int64_t>(path, h.offsets_at + 2 * sizeof(std::int64_t), g.offsets[3] + 1);
+        else if (corrupt == 1)
+            Patch<int>(path, h.neighbors_at + 5 * sizeof(int), g.V);
+        else if (corrupt == 2)
+            Patch<int>(path, h.neighbors_at, -1);
+        else if (corrupt == 3)
+            Patch<std::int64_t>(path, h.names_at + sizeof(std::int64_t), 3);
+        else if (corrupt == 4)
+            Patch<char>(path, h.names_at + (g.V + 1) * sizeof(std::int64_t) + 1, 'x');
+        // sizes whose byte counts wrap around
+        else if (corrupt == 5)
+            Patch<std::int64_t>(path, offsetof(GraphFileHeader, slots), std::int64_t(1) << 62);
+        else if (corrupt == 6)
+            Patch<std::int64_t>(path, offsetof(GraphFileHeader, V), std::int64_t(1) << 61);
+        else
+            Patch<std::int64_t>(path, h.names_at + g.V * sizeof(std::int64_t), INT64_MAX - 8);
+        assert(!m.Open(path) && !m.IsOpen());
+    }
+    std::remove(path.c_str());
+}
+
+void TestWeighted() {
+    const std::string path = TempPath("test_graph_file_w.bin");
+    const WeightedCsrGraphF64 g(WeightedGraph_1());
+    assert(WriteGraphFile(path, g));
+    MappedGraph m;
+    assert(m.Open(path));
+    CheckSame(g.Topology(), m);
+    assert(m.WeightType() == kFloat64Weight && m.Weights<float>(1).empty());
+    for (int u = 0; u < g.V; u++) {
+        const auto a = g.Weights(u), b = m.Weights<double>(u);
+        assert(std::vector<double>(a.begin(), a.end()) == std::vector<double>(b.begin(), b.end()));
+    }
+    WeightedGraphView<double> view;
+    WeightedGraphView<float> wrong;
+    assert(m.View(view) && !m.View(wrong));
+    assert(view.V == g.V && view.E == g.E && view.Weights(2)[0] == g.Weights(2)[0]);
+
+    // the weighted engines run on the mapped file
+    Dijkstra<double> over_file(view), in_memory(g);
+    DeltaStepping<double> delta(view);
+    over_file.Run(0);
+    in_memory.Run(0);
+    delta.Run(0);
+    assert(over_file.dist == in_memory.dist && delta.dist == in_memory.dist);
+    assert(BidirectionalDijkstra<double>(view).Run(0, g.V - 1) == in_memory.dist[g.V - 1]);
+    assert(Prim(view).weight == Prim(g).weight && Kruskal(view).weight == Prim(g).weight);
+    MaxFlow<double> flow(view);
+    assert(flow.Dinic(0, g.V - 1) == MaxFlow<double>(g).Dinic(0, g.V - 1));
+    std::remove(path.c_str());
+}
+
+void TestConvert() {
+    const std::string text = TempPath("test_graph_file.txt");
+    const std::string path = TempPath("test_graph_file_c.bin");
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> vertex(0, 999);
+    std::uniform_int_distribution<int> weight(1, 100);
+    std::vector<Edge> edges;
+    {
+        std::ofstream out(text);
+        out << "# comment\n% comment\n\n";
+        for (int i = 0; i < 5000; i++) {
+            edges.push_back(Edge(vertex(gen), vertex(gen), weight(gen)));
+            out << edges.back().u << "\t" << edges.back().v << " " << edges.back().w << "\n";
+        }
+    }
+    int V = 0;
+    for (const auto& e : edges) {
+        V = std::max(V, std::max(e.u, e.v) + 1);
+    }
+
+    for (bool directed : {false, true}) {
+        assert(ConvertEdgeList(text, path, directed));
+        MappedGraph m;
+        assert(m.Open(path));
+        CheckSame(CsrGraph(V, edges, directed), m);
+        m.Close();
+
+        assert(ConvertEdgeList(text, path, directed, kInt32Weight));
+        assert(m.Open(path));
+        const WeightedCsrGraphI32 g(V, edges, directed);
+        CheckSame(g.Topology(), m);
+        for (int u = 0; u < g.V; u++) {
+            const auto a = g.Weights(u), b = m.Weights<std::int32_t>(u);
+            assert(std::vector<int>(a.begin(), a.end()) == std::vector<int>(b.begin(), b.end()));
+        }
+    }
+
+    // lines longer than any fixed buffer
+    {
+        std::ofstream out(text);
+        out << "# " << std::string(10000, 'x') << "\n" << std::string(10000, ' ') << "1 2\n2 3 "
+            << std::string(10000, ' ') << "# 4 5\n";
+    }
+    assert(ConvertEdgeList(text, path, false));
+    MappedGraph m;
+    assert(m.Open(path) && m.V == 4 && m.E == 2);
+    m.Close();
+
+    // a failed conversion leaves the old file in place
+    {
+        std::ofstream out(text);
+        out << "1 2\n3 x\n";
+    }
+    assert(!ConvertEdgeList(text, path, false));
+    assert(m.Open(path) && m.V == 4 && m.E == 2);
+    m.Close();
+    {
+        std::ofstream out(text);
+        out << "1 2147483647\n";
+    }
+    assert(!ConvertEdgeList(text, path, false));
+    assert(m.Open(path) && m.V == 4 && m.E == 2);
+    m.Close();
+    std::remove(text.c_str());
+    std::remove(path.c_str());
+}
+} // namespace
+
+int main() {
+    TestCsr();
+    TestWeighted();
+    TestConvert();
+    std::cout << "Success" << std::endl;
+    return 0;
+}
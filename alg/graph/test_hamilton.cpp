@@ -0,0 +1,139 @@
+#include <cassert>
+#include <iostream>
+#include <random>
+
+#include "hamilton.h"
+#include "instance.h"
+
+using namespace alg;
+
+namespace {
+bool IsHamiltonPath(const CsrGraph& g, int u, int v, const std::vector<int>& path) {
+    if (static_cast<int>(path.size()) != g.V || path.front() != u || path.back() != v)
+        return false;
+    std::vector<bool> seen(g.V, false);
+    for (std::size_t i = 0; i < path.size(); i++) {
+        if (seen[path[i]])
+            return false;
+        seen[path[i]] = true;
+        if (i > 0) {
+            const auto nodes = g.Adj(path[i - 1]);
+            if (!std::binary_search(nodes.begin(), nodes.end(), path[i]))
+                return false;
+        }
+    }
+    return true;
+}
+
+CsrGraph RandomGraph(int n, double p, std::mt19937& gen, bool directed = false) {
+    std::bernoulli_distribution coin(p);
+    std::vector<Edge> edges;
+    for (int i = 0; i < n; i++) {
+        for (int j = directed ? 0 : i + 1; j < n; j++) {
+            if (i != j && coin(gen))
+                edges.push_back(Edge(i, j));
+        }
+    }
+    return CsrGraph(n, edges, directed);
+}
+
+CsrGraph Grid(int rows, int cols) {
+    std::vector<Edge> edges;
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            if (c + 1 < cols)
+                edges.push_back(Edge(r * cols + c, r * cols + c + 1));
+            if (r + 1 < rows)
+                edges.push_back(Edge(r * cols + c, (r + 1) * cols + c));
+        }
+    }
+    return CsrGraph(rows * cols, edges);
+}
+} // namespace
+
+int main() {
+    // instances
+    {
+        CsrGraph g2(Graph_2()), g3(Graph_3());
+        std::vector<int> p;
+        assert(!Hamilton(g2).HeldKarp(0, 5, p));
+        assert(!Hamilton(g2).Backtrack(0, 5, p));
+        assert(Hamilton(g3).HeldKarp(0, 5, p) && IsHamiltonPath(g3, 0, 5, p));
+        assert(Hamilton(g3).Backtrack(0, 5, p) && IsHamiltonPath(g3, 0, 5, p));
+    }
+
+    // DP and backtracking agree on random graphs
+    ThreadPool pool(3);
+    std::mt19937 gen(11);
+    for (int round = 0; round < 200; round++) {
+        int n = 2 + round % 10;
+        CsrGraph g = RandomGraph(n, 0.35, gen);
+        Hamilton hamilton(g);
+        for (int u = 0; u < n; u++) {
+            int v = (u + 1 + round) % n;
+            std::vector<int> p1, p2, p3;
+            bool found = hamilton.HeldKarp(u, v, p1);
+            assert(hamilton.HeldKarp(u, v, p2, &pool) == found);
+            assert(hamilton.Backtrack(u, v, p3) == found);
+            if (found) {
+                assert(IsHamiltonPath(g, u, v, p1));
+                assert(IsHamiltonPath(g, u, v, p2));
+                assert(IsHamiltonPath(g, u, v, p3));
+            }
+        }
+    }
+
+    // directed graphs follow their edges
+    {
+        const CsrGraph line(4, {Edge(0, 1), Edge(1, 2), Edge(2, 3)}, true);
+        std::vector<int> p;
+        assert(Hamilton(line).HeldKarp(0, 3, p) && p == std::vector<int>({0, 1, 2, 3}));
+        assert(Hamilton(line).HeldKarp(0, 3, p, &pool) && p == std::vector<int>({0, 1, 2, 3}));
+        assert(Hamilton(line).Backtrack(0, 3, p) && p == std::vector<int>({0, 1, 2, 3}));
+        assert(!Hamilton(line).HeldKarp(3, 0, p) && !Hamilton(line).Backtrack(3, 0, p));
+    }
+    for (int round = 0; round < 200; round++) {
+        int n = 2 + round % 10;
+        CsrGraph g = RandomGraph(n, 0.3, gen, true);
+        Hamilton hamilton(g);
+        for (int u = 0; u < n; u++) {
+            int v = (u + 1 + round) % n;
+            std::vector<int> p1, p2, p3;
+            bool found = hamilton.HeldKarp(u, v, p1);
+            assert(hamilton.HeldKarp(u, v, p2, &pool) == found);
+            assert(hamilton.Backtrack(u, v, p3) == found);
+            if (found) {
+                assert(IsHamiltonPath(g, u, v, p1));
+                assert(IsHamiltonPath(g, u, v, p2));
+                assert(IsHamiltonPath(g, u, v, p3));
+            }
+        }
+    }
+
+    // scheduling sized graph
+    {
+        CsrGraph g = RandomGraph(24, 0.2, gen);
+        std::vector<int> p1, p2;
+        bool found = Hamilton(g).HeldKarp(0, 23, p1, &pool);
+        assert(Hamilton(g).Backtrack(0, 23, p2) == found);
+        assert(!found || IsHamiltonPath(g, 0, 23, p1));
+    }
+
+    // beyond the DP limit
+    {
+        CsrGraph g = RandomGraph(200, 0.05, gen);
+        std::vector<int> p;
+        assert(Hamilton(g).Path(0, 199, p));
+        assert(IsHamiltonPath(g, 0, 199, p));
+    }
+    {
+        CsrGraph g = Grid(6, 6);
+        std::vector<int> p;
+        assert(Hamilton(g).Path(0, 5, p));
+        assert(IsHamiltonPath(g, 0, 5, p));
+        // both ends have the same color on an even sized grid
+        assert(!Hamilton(g).Path(0, 24, p));
+    }
+
+    std::cout << "Success" << std::endl;
+}
@@ -0,0 +1,162 @@
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "generator.h"
+#include "max_flow.h"
+
+using namespace alg;
+
+namespace {
+// capacities and conservation hold, and the flow fills a cut: then it is
+// maximum and the cut minimum
+template <typename W>
+void AssertMaxFlow(const MaxFlow<W>& f, const std::vector<Edge>& edges, int s, int t, double eps = 0) {
+    std::vector<double> net(f.V, 0);
+    for (int i = 0; i < static_cast<int>(edges.size()); i++) {
+        const double flow = f.Flow(i);
+        assert(flow >= -eps && flow <= edges[i].w + eps);
+        net[edges[i].u] -= flow;
+        net[edges[i].v] += flow;
+    }
+    for (int v = 0; v < f.V; v++) {
+        if (v != s && v != t)
+            assert(std::fabs(net[v]) <= eps);
+    }
+    assert(std::fabs(net[t] - f.Value()) <= eps && std::fabs(net[s] + f.Value()) <= eps);
+
+    const std::vector<char> side = f.MinCut();
+    assert(side[s] && !side[t]);
+    double cut = 0;
+    for (int i : f.CutEdges()) {
+        cut += edges[i].w;
+    }
+    assert(std::fabs(cut - f.Value()) <= eps);
+    for (int i = 0; i < static_cast<int>(edges.size()); i++) {
+        if (!side[edges[i].u] && side[edges[i].v])
+            assert(f.Flow(i) <= eps);
+    }
+}
+
+std::vector<Edge> RandomNetwork(int V, double p, int max_capacity, std::uint64_t seed) {
+    std::vector<Edge> edges = GnpEdges(V, p, seed, true);
+    RandomWeights(edges, max_capacity, seed);
+    return edges;
+}
+} // namespace
+
+int main() {
+    // CLRS network, on the dense matrix
+    {
+        DirectedWeightedGraph g(6);
+        g.AddEdge(0, 1, 16);
+        g.AddEdge(0, 2, 13);
+        g.AddEdge(1, 3, 12);
+        g.AddEdge(2, 1, 4);
+        g.AddEdge(2, 4, 14);
+        g.AddEdge(3, 2, 9);
+        g.AddEdge(3, 5, 20);
+        g.AddEdge(4, 3, 7);
+        g.AddEdge(4, 5, 4);
+        MaxFlow<double> push(g), dinic(g);
+        assert(push.PushRelabel(0, 5) == 23);
+        assert(dinic.Dinic(0, 5) == 23);
+        AssertMaxFlow(push, g.Edges(), 0, 5);
+        AssertMaxFlow(dinic, g.Edges(), 0, 5);
+        assert(push.MinCut() == std::vector<char>({1, 1, 1, 0, 1, 0}));
+        assert(push.PushRelabel(2, 2) == 0);
+    }
+
+    // random networks, both algorithms, many terminal pairs
+    for (std::uint64_t seed = 1; seed <= 6; seed++) {
+        const int V = 200;
+        const auto edges = RandomNetwork(V, seed % 2 ? 0.03 : 0.1, 100, seed);
+        MaxFlow<int> push(V, edges), dinic(V, edges);
+        std::mt19937 gen(static_cast<unsigned>(seed));
+        std::uniform_int_distribution<int> vertex(0, V - 1);
+        for (int round = 0; round < 10; round++) {
+            const int s = vertex(gen), t = vertex(gen);
+            if (s == t)
+                continue;
+            const std::int64_t value = push.PushRelabel(s, t);
+            assert(dinic.Dinic(s, t) == value);
+            AssertMaxFlow(push, edges, s, t);
+            AssertMaxFlow(dinic, edges, s, t);
+        }
+    }
+
+    // unit capacities: edge-disjoint paths across a grid
+    {
+        auto edges = GridEdges(30, 30, 0.8, 3);
+        const std::size_t m = edges.size();
+        for (std::size_t i = 0; i < m; i++) {
+            edges[i].w = 1;
+            edges.push_back(Edge(edges[i].v, edges[i].u, 1));
+        }
+        MaxFlow<int> push(900, edges), dinic(900, edges);
+        const std::int64_t value = dinic.Dinic(0, 899);
+        assert(value >= 1 && value <= 2);
+        assert(push.PushRelabel(0, 899) == value);
+        AssertMaxFlow(dinic, edges, 0, 899);
+    }
+
+    // undirected graphs carry flow either way
+    {
+        auto edges = RandomNetwork(100, 0.05, 20, 9);
+        const WeightedCsrGraph<int> g(100, edges);
+        MaxFlow<int> f(g);
+        const std::int64_t value = f.PushRelabel(0, 1);
+        auto both = g.Edges();
+        const std::size_t m = both.size();
+        for (std::size_t i = 0; i < m; i++) {
+            both.push_back(Edge(both[i].v, both[i].u, both[i].w));
+        }
+        AssertMaxFlow(f, both, 0, 1);
+        MaxFlow<int> directed(100, both);
+        assert(directed.Dinic(0, 1) == value);
+    }
+
+    // capacity changes re-solve from the last flow
+    for (bool use_dinic : {false, true}) {
+        const int V = 150;
+        auto edges = RandomNetwork(V, 0.06, 50, 4);
+        MaxFlow<int> f(V, edges);
+        const int s = 3, t = 77;
+        use_dinic ? f.Dinic(s, t) : f.PushRelabel(s, t);
+        std::mt19937 gen(8);
+        std::uniform_int_distribution<int> edge(0, static_cast<int>(edges.size()) - 1), capacity(0, 60);
+        for (int round = 0; round < 60; round++) {
+            // cuts through the current cut half of the time
+            const auto cut = f.CutEdges();
+            const int i = round % 2 && !cut.empty() ? cut[round % cut.size()] : edge(gen);
+            const int c = round % 3 ? capacity(gen) : 0;
+            assert(f.SetCapacity(i, c));
+            edges[i].w = c;
+            // still feasible before the re-solve
+            for (int k = 0; k < static_cast<int>(edges.size()); k++) {
+                assert(f.Flow(k) >= 0 && f.Flow(k) <= edges[k].w);
+            }
+            const std::int64_t value = use_dinic ? f.Dinic(s, t) : f.PushRelabel(s, t);
+            AssertMaxFlow(f, edges, s, t);
+            MaxFlow<int> fresh(V, edges);
+            assert(fresh.PushRelabel(s, t) == value);
+        }
+        assert(!f.SetCapacity(-1, 1) && !f.SetCapacity(static_cast<int>(edges.size()), 1) && !f.SetCapacity(0, -1));
+    }
+
+    // fractional capacities
+    {
+        auto edges = RandomNetwork(80, 0.1, 1000, 5);
+        for (auto& e : edges) {
+            e.w /= 7;
+        }
+        MaxFlow<double> push(80, edges), dinic(80, edges);
+        const double value = push.PushRelabel(0, 79);
+        assert(std::fabs(dinic.Dinic(0, 79) - value) < 1e-6);
+        AssertMaxFlow(push, edges, 0, 79, 1e-6);
+        AssertMaxFlow(dinic, edges, 0, 79, 1e-6);
+    }
+    std::cout << "Success" << std::endl;
+}
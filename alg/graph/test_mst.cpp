@@ -0,0 +1,103 @@
+#include <cassert>
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+#include "alg/common/thread_pool.h"
+#include "components.h"
+#include "instance.h"
+#include "mst.h"
+
+using namespace alg;
+
+namespace {
+std::vector<Edge> RandomEdges(int n, int m, int max_w, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    std::uniform_int_distribution<int> weight(-max_w, max_w);
+    std::vector<Edge> edges;
+    for (int i = 0; i < m; i++) {
+        edges.push_back(Edge(vertex(gen), vertex(gen), weight(gen)));
+    }
+    return edges;
+}
+
+double Reference(int V, std::vector<Edge> edges) {
+    std::stable_sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) {
+        return a.w < b.w;
+    });
+    UnionFind uf(V);
+    double weight = 0;
+    for (const auto& e : edges) {
+        if (uf.Union(e.u, e.v))
+            weight += e.w;
+    }
+    return weight;
+}
+
+// spanning forest of the components of edges
+void CheckForest(int V, const std::vector<Edge>& edges, const SpanningForest& forest, double weight) {
+    UnionFind all(V), tree(V);
+    for (const auto& e : edges) {
+        all.Union(e.u, e.v);
+    }
+    double sum = 0;
+    for (const auto& e : forest.edges) {
+        assert(tree.Union(e.u, e.v));
+        sum += e.w;
+    }
+    assert(tree.Count() == all.Count());
+    assert(sum == forest.weight);
+    assert(forest.weight == weight);
+}
+
+bool SameEdges(const SpanningForest& a, const SpanningForest& b) {
+    if (a.edges.size() != b.edges.size())
+        return false;
+    for (std::size_t i = 0; i < a.edges.size(); i++) {
+        if (a.edges[i].u != b.edges[i].u || a.edges[i].v != b.edges[i].v || a.edges[i].w != b.edges[i].w)
+            return false;
+    }
+    return true;
+}
+
+void TestEdges(int V, const std::vector<Edge>& edges, ThreadPool& pool) {
+    const double weight = Reference(V, edges);
+    const auto kruskal = Kruskal(V, edges);
+    CheckForest(V, edges, kruskal, weight);
+    // one total order, so every variant finds the same forest
+    assert(SameEdges(kruskal, Kruskal(V, edges, &pool)));
+    assert(SameEdges(kruskal, Boruvka(V, edges)));
+    assert(SameEdges(kruskal, Boruvka(V, edges, &pool)));
+
+    const WeightedCsrGraphF64 g(V, edges);
+    CheckForest(V, edges, Prim(g), Reference(V, g.Edges()));
+    CheckForest(V, edges, Prim(WeightedCsrGraphI32(V, edges)), Reference(V, g.Edges()));
+    CheckForest(V, edges, Kruskal(g, &pool), Reference(V, g.Edges()));
+    CheckForest(V, edges, Boruvka(g, &pool), Reference(V, g.Edges()));
+}
+} // namespace
+
+int main() {
+    ThreadPool pool(4);
+
+    const WeightedGraph w1 = WeightedGraph_1();
+    const auto edges1 = w1.Edges();
+    const double weight1 = Reference(w1.V, edges1);
+    assert(weight1 == 23);
+    CheckForest(w1.V, edges1, Kruskal(w1), weight1);
+    CheckForest(w1.V, edges1, Boruvka(w1, &pool), weight1);
+    CheckForest(w1.V, edges1, Prim(w1), weight1);
+    CheckForest(w1.V, edges1, Prim(WeightedCsrGraphF32(w1)), weight1);
+
+    TestEdges(1, {}, pool);
+    TestEdges(10, {Edge(3, 3, 1), Edge(1, 2, 4), Edge(2, 1, 2)}, pool);
+    for (unsigned seed = 1; seed <= 5; seed++) {
+        TestEdges(500, RandomEdges(500, 700, 10, seed), pool);
+        TestEdges(2000, RandomEdges(2000, 20000, 1000, seed), pool);
+    }
+    TestEdges(100000, RandomEdges(100000, 400000, 1 << 30, 9), pool);
+
+    std::cout << "Success" << std::endl;
+    return 0;
+}
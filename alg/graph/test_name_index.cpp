@@ -1,11 +1,15 @@
 #include <cassert>
 #include <iostream>
+#include <random>
+#include <string>
+#include <vector>
 #include "name_index.h"
 
 using namespace alg;
 
 int main() {
     NameIndex ni;
+    assert(ni.Find("but") == -1);
     assert(ni.IndexByName("but") == 0);
     assert(ni.IndexByName("that") == 1);
     assert(ni.IndexByName("river") == 2);
@@ -14,5 +18,58 @@ int main() {
     assert(ni.IndexByName("dog") == 4);
     assert(ni.IndexByName("that") == 1);
     assert(ni.Count() == 5);
+    assert(ni.Find("river") == 2 && ni.Find("riv") == -1 && ni.Find("rivers") == -1);
+    assert(ni.IndexByName("") == 5 && ni.Find("") == 5);
+
+    // random names with shared prefixes against a map
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> len(1, 12), letter('a', 'e');
+    std::vector<std::string> names;
+    for (int i = 0; i < 20000; i++) {
+        std::string s;
+        for (int k = len(gen); k > 0; k--) {
+            s += static_cast<char>(letter(gen));
+        }
+        names.push_back(s);
+    }
+    NameIndex index;
+    std::vector<int> ids;
+    for (const auto& s : names) {
+        ids.push_back(index.IndexByName(s.c_str()));
+    }
+    for (std::size_t i = 0; i < names.size(); i++) {
+        assert(index.Find(names[i].c_str()) == ids[i]);
+    }
+
+    std::vector<const char*> queries;
+    for (const auto& s : names) {
+        queries.push_back(s.c_str());
+    }
+    queries.push_back("zzz");
+    queries.push_back("");
+    std::vector<int> found(queries.size());
+    index.FindBatch(queries.data(), queries.size(), found.data());
+    for (std::size_t i = 0; i < names.size(); i++) {
+        assert(found[i] == ids[i]);
+    }
+    assert(found[names.size()] == -1 && found[names.size() + 1] == -1);
+
+    // a snapshot keeps its names, a frozen index moves them out
+    NameIndexSnapshot snapshot = index.Snapshot();
+    const int count = index.Count();
+    assert(index.IndexByName("new name") == count);
+    assert(snapshot.Count() == count && snapshot.Find("new name") == -1);
+    assert(snapshot.Find(names[7].c_str()) == ids[7]);
+
+    NameIndexSnapshot frozen = index.Freeze();
+    assert(index.Count() == 0 && index.Find(names[0].c_str()) == -1);
+    assert(frozen.Count() == count + 1 && frozen.Find("new name") == count);
+    NameIndexSnapshot moved = std::move(frozen);
+    moved.FindBatch(queries.data(), names.size(), found.data());
+    assert(std::equal(ids.begin(), ids.end(), found.begin()));
+
+    NameIndexSnapshot empty;
+    empty.FindBatch(queries.data(), 3, found.data());
+    assert(found[0] == -1 && found[2] == -1);
     std::cout << "Success" << std::endl;
 }
@@ -114,13 +114,13 @@ int main() {
     }
 
     // dfs bcc
-//    std::cout << "*** dfs bcc" << std::endl;
-//    {
-//        const auto& graph = Graph_7();
-//        Path path(graph);
-//        DFS dfs(graph.V);
-//        std::vector<int> separations;
-//        path.DfsSeparationVertices(dfs, Edge(0, 1), separations);
-//        PrintSeparations(separations);
-//    }
+    std::cout << "*** dfs bcc" << std::endl;
+    {
+        const auto& graph = Graph_7();
+        Path path(graph);
+        DFS dfs(graph.V);
+        std::vector<int> separations;
+        path.DfsSeparationVertices(dfs, separations);
+        PrintSeparations(separations);
+    }
 }
@@ -0,0 +1,124 @@
+#include <cassert>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "alg/common/thread_pool.h"
+#include "generator.h"
+#include "path.h"
+#include "reorder.h"
+#include "search.h"
+
+using namespace alg;
+
+namespace {
+bool IsPermutation(const Permutation& p, int V) {
+    if (p.Size() != V || static_cast<int>(p.old_id.size()) != V)
+        return false;
+    for (int v = 0; v < V; v++) {
+        if (p.old_id[p.new_id[v]] != v)
+            return false;
+    }
+    return true;
+}
+
+// every edge of g appears renamed in r
+bool SameGraph(const CsrGraph& g, const CsrGraph& r, const Permutation& p) {
+    if (r.V != g.V || r.E != g.E || r.neighbors.size() != g.neighbors.size())
+        return false;
+    for (int u = 0; u < g.V; u++) {
+        const auto row = r.Adj(p.new_id[u]);
+        if (!std::is_sorted(row.begin(), row.end()))
+            return false;
+        for (int v : g.Adj(u)) {
+            if (!std::binary_search(row.begin(), row.end(), p.new_id[v]))
+                return false;
+        }
+    }
+    return true;
+}
+
+int Bandwidth(const CsrGraph& g) {
+    int b = 0;
+    for (int u = 0; u < g.V; u++) {
+        for (int v : g.Adj(u)) {
+            b = std::max(b, std::abs(u - v));
+        }
+    }
+    return b;
+}
+} // namespace
+
+int main() {
+    ThreadPool pool(4);
+    const CsrGraph g(1 << 12, RMatEdges(12, 8, 5));
+
+    for (const Permutation& p : {DegreeOrder(g), HubSortOrder(g), BfsOrder(g), BfsOrder(g, 7), RcmOrder(g)}) {
+        assert(IsPermutation(p, g.V));
+        const CsrGraph r = Relabel(g, p);
+        assert(SameGraph(g, r, p));
+        const CsrGraph rp = Relabel(g, p, &pool);
+        assert(rp.offsets == r.offsets && rp.neighbors == r.neighbors);
+
+        // searches on the relabeled graph map back to the original ids
+        BFS original(g.V), relabeled(g.V);
+        original.Run(g, 3);
+        relabeled.Run(r, p.new_id[3]);
+        assert(p.Restore(relabeled.dist) == original.dist);
+        assert(p.Apply(p.Restore(relabeled.dist)) == relabeled.dist);
+
+        DFS dfs(g.V);
+        Path(r).Dfs(dfs);
+        const std::vector<int> st = p.RestoreIds(dfs.st);
+        assert(p.ApplyIds(st) == dfs.st);
+        for (int v = 0; v < g.V; v++) {
+            const auto row = g.Adj(v);
+            assert(st[v] == v || std::find(row.begin(), row.end(), st[v]) != row.end());
+        }
+    }
+
+    {
+        const Permutation p = DegreeOrder(g);
+        for (int k = 1; k < g.V; k++) {
+            assert(g.Deg(p.old_id[k - 1]) >= g.Deg(p.old_id[k]));
+        }
+        const Permutation hub = HubSortOrder(g);
+        const double mean = static_cast<double>(g.neighbors.size()) / g.V;
+        assert(g.Deg(hub.old_id[0]) == g.Deg(p.old_id[0]) && g.Deg(hub.old_id[g.V - 1]) <= mean);
+        const Permutation bfs = BfsOrder(g, 7);
+        assert(bfs.old_id[0] == 7 && bfs.new_id[7] == 0);
+    }
+
+    // RCM recovers a narrow band from a shuffled grid
+    {
+        const int side = 40;
+        std::vector<int> shuffle(side * side);
+        std::iota(shuffle.begin(), shuffle.end(), 0);
+        std::shuffle(shuffle.begin(), shuffle.end(), std::mt19937(2));
+        const CsrGraph grid = Relabel(CsrGraph(side * side, GridEdges(side, side, 1.0, 1)), Permutation(shuffle));
+        assert(Bandwidth(grid) > 10 * side);
+        assert(Bandwidth(Relabel(grid, RcmOrder(grid))) <= 2 * side);
+    }
+
+    // weights follow their edges
+    {
+        std::vector<Edge> edges = GnpEdges(300, 0.05, 4, true);
+        RandomWeights(edges, 100, 4);
+        const WeightedCsrGraph<int> w(300, edges, true);
+        const Permutation p = RcmOrder(w.View());
+        const WeightedCsrGraph<int> r = Relabel(WeightedGraphView<int>(w), p, &pool);
+        assert(r.E == w.E && r.directed);
+        for (int u = 0; u < w.V; u++) {
+            for (const auto& a : w.Edges(u)) {
+                const auto t = r.Targets(p.new_id[u]);
+                const auto it = std::lower_bound(t.begin(), t.end(), p.new_id[a.v]);
+                assert(it != t.end() && *it == p.new_id[a.v]);
+                assert(r.Weights(p.new_id[u])[it - t.begin()] == a.w);
+            }
+        }
+    }
+    std::cout << "Success" << std::endl;
+}
@@ -0,0 +1,142 @@
+#include <cassert>
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+#include "scc.h"
+#include "topo_sort.h"
+
+using namespace alg;
+
+namespace {
+CsrGraph RandomDigraph(int n, int m, unsigned seed, bool dag) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    std::vector<Edge> edges;
+    for (int i = 0; i < m; i++) {
+        int u = vertex(gen), v = vertex(gen);
+        if (dag && u == v)
+            continue;
+        if (dag && u > v)
+            std::swap(u, v);
+        edges.push_back(Edge(u, v));
+    }
+    return CsrGraph(n, edges, true);
+}
+
+std::vector<std::vector<bool>> Reach(const CsrGraph& g) {
+    std::vector<std::vector<bool>> reach(g.V, std::vector<bool>(g.V, false));
+    for (int s = 0; s < g.V; s++) {
+        std::vector<int> st = {s};
+        reach[s][s] = true;
+        while (!st.empty()) {
+            int u = st.back();
+            st.pop_back();
+            for (int w : g.Adj(u)) {
+                if (!reach[s][w]) {
+                    reach[s][w] = true;
+                    st.push_back(w);
+                }
+            }
+        }
+    }
+    return reach;
+}
+
+bool IsTopological(const CsrGraph& g, const std::vector<int>& order) {
+    std::vector<int> pos(g.V, -1);
+    for (std::size_t i = 0; i < order.size(); i++) {
+        pos[order[i]] = i;
+    }
+    for (int u = 0; u < g.V; u++) {
+        for (int w : g.Adj(u)) {
+            if (pos[u] == -1 || pos[w] == -1 || pos[u] >= pos[w])
+                return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main() {
+    ThreadPool pool(4);
+
+    // components against brute force reachability
+    for (int round = 0; round < 100; round++) {
+        int n = 1 + round % 20;
+        CsrGraph g = RandomDigraph(n, n + round % 13, round, false);
+        SCC scc(g);
+        scc.Run();
+        const auto reach = Reach(g);
+        for (int u = 0; u < n; u++) {
+            for (int v = 0; v < n; v++) {
+                assert(scc.StronglyConnected(u, v) == (reach[u][v] && reach[v][u]));
+            }
+        }
+
+        // ids follow a topological order of the condensation
+        CsrGraph dag = scc.Condensation();
+        assert(dag.V == scc.Count());
+        for (int c = 0; c < dag.V; c++) {
+            for (int d : dag.Adj(c)) {
+                assert(c < d);
+            }
+        }
+        TopoSort topo(dag);
+        assert(topo.Run());
+        assert(IsTopological(dag, topo.order));
+
+        // acyclic iff every component is a single vertex without a self loop
+        bool acyclic = scc.Count() == n;
+        for (int u = 0; u < n; u++) {
+            const auto nodes = g.Adj(u);
+            acyclic = acyclic && !std::binary_search(nodes.begin(), nodes.end(), u);
+        }
+        TopoSort cyclic(g);
+        assert(cyclic.Run() == acyclic);
+    }
+
+    // levels
+    {
+        CsrGraph g(5, {Edge(0, 2), Edge(1, 2), Edge(2, 3), Edge(0, 3), Edge(3, 4)}, true);
+        TopoSort topo(g);
+        assert(topo.Run(&pool));
+        assert(topo.order == std::vector<int>({0, 1, 2, 3, 4}));
+        assert(topo.Levels() == 4);
+        assert(topo.Level(0).size() == 2 && topo.level[4] == 3);
+    }
+
+    // large dag, parallel and sequential orders agree
+    {
+        CsrGraph g = RandomDigraph(1000000, 4000000, 3, true);
+        TopoSort seq(g), par(g);
+        assert(seq.Run());
+        assert(par.Run(&pool));
+        assert(seq.order == par.order && seq.level == par.level);
+        assert(IsTopological(g, seq.order));
+
+        SCC scc(g);
+        scc.Run();
+        assert(scc.Count() == g.V);
+    }
+
+    // long cycle, far beyond the recursion limit
+    {
+        const int n = 1000000;
+        std::vector<Edge> edges;
+        for (int i = 0; i < n; i++) {
+            edges.push_back(Edge(i, (i + 1) % n));
+        }
+        edges.push_back(Edge(n / 2, n));
+        CsrGraph g(n + 1, edges, true);
+        SCC scc(g);
+        scc.Run();
+        assert(scc.Count() == 2);
+        assert(scc.id[n] == 1 && scc.id[0] == 0);
+        TopoSort topo(g);
+        assert(!topo.Run(&pool));
+        assert(topo.order.empty());
+    }
+
+    std::cout << "Success" << std::endl;
+}
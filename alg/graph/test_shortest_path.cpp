@@ -0,0 +1,218 @@
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+#include "alg/common/thread_pool.h"
+#include "instance.h"
+#include "shortest_path.h"
+
+using namespace alg;
+
+namespace {
+std::vector<Edge> RandomEdges(int n, int m, int max_w, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    std::uniform_int_distribution<int> weight(1, max_w);
+    std::vector<Edge> edges;
+    for (int i = 0; i < m; i++) {
+        edges.push_back(Edge(vertex(gen), vertex(gen), weight(gen)));
+    }
+    return edges;
+}
+
+// Bellman-Ford over the CSR rows
+template <typename W>
+std::vector<Distance<W>> Reference(const WeightedCsrGraph<W>& g, int s) {
+    std::vector<Distance<W>> dist(g.V, Unreached<W>());
+    dist[s] = 0;
+    for (bool changed = true; changed; ) {
+        changed = false;
+        for (int u = 0; u < g.V; u++) {
+            if (dist[u] == Unreached<W>())
+                continue;
+            for (const auto& a : g.Edges(u)) {
+                if (dist[u] + a.w < dist[a.v]) {
+                    dist[a.v] = dist[u] + a.w;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return dist;
+}
+
+template <typename W>
+Distance<W> Length(const WeightedCsrGraph<W>& g, const std::vector<int>& path) {
+    Distance<W> len = 0;
+    for (std::size_t i = 0; i + 1 < path.size(); i++) {
+        const auto t = g.Targets(path[i]);
+        auto it = std::lower_bound(t.begin(), t.end(), path[i + 1]);
+        assert(it != t.end() && *it == path[i + 1]);
+        len += g.Weights(path[i])[it - t.begin()];
+    }
+    return len;
+}
+
+template <typename W, typename Engine>
+void CheckEngine(const WeightedCsrGraph<W>& g, Engine& engine, int s,
+                 const std::vector<Distance<W>>& expected) {
+    std::vector<int> path;
+    for (int v = 0; v < g.V; v++) {
+        assert(engine.dist[v] == expected[v]);
+        assert(engine.Reached(v) == (expected[v] != Unreached<W>()));
+        if (engine.PathTo(v, path)) {
+            assert(path.front() == s && path.back() == v);
+            assert(Length(g, path) == expected[v]);
+        }
+    }
+}
+
+template <typename W>
+void TestGraph(const WeightedCsrGraph<W>& g, ThreadPool& pool) {
+    const auto back = g.Transpose();
+    Dijkstra<W> quad(g);
+    BinaryDijkstra<W> binary(g);
+    DeltaStepping<W> delta(g);
+    BidirectionalDijkstra<W> bidir(g, back);
+    std::vector<int> path;
+
+    for (int s = 0; s < g.V; s += 1 + g.V / 7) {
+        const auto expected = Reference(g, s);
+        quad.Run(s);
+        CheckEngine(g, quad, s, expected);
+        binary.Run(s);
+        CheckEngine(g, binary, s, expected);
+        delta.Run(s, &pool);
+        CheckEngine(g, delta, s, expected);
+        delta.Run(s, 1, nullptr);
+        CheckEngine(g, delta, s, expected);
+
+        for (int t = 0; t < g.V; t += 1 + g.V / 11) {
+            assert(quad.Run(s, t) == expected[t]);
+            assert(bidir.Run(s, t) == expected[t]);
+            assert(bidir.Path(path) == (expected[t] != Unreached<W>()));
+            if (!path.empty()) {
+                assert(path.front() == s && path.back() == t);
+                assert(Length(g, path) == expected[t]);
+            }
+        }
+    }
+}
+
+void TestRadix(const WeightedCsrGraphI32& g) {
+    RadixDijkstra<std::int32_t> radix(g);
+    for (int s = 0; s < g.V; s += 1 + g.V / 7) {
+        const auto expected = Reference(g, s);
+        radix.Run(s);
+        CheckEngine(g, radix, s, expected);
+    }
+}
+
+// A* on a grid with the Manhattan distance, every weight is at least 1
+void TestAStar() {
+    const int n = 40;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> weight(1, 9);
+    std::vector<Edge> edges;
+    for (int r = 0; r < n; r++) {
+        for (int c = 0; c < n; c++) {
+            if (c + 1 < n)
+                edges.push_back(Edge(r * n + c, r * n + c + 1, weight(gen)));
+            if (r + 1 < n)
+                edges.push_back(Edge(r * n + c, (r + 1) * n + c, weight(gen)));
+        }
+    }
+    WeightedCsrGraphI32 g(n * n, edges);
+    Dijkstra<std::int32_t> dijkstra(g);
+    RadixDijkstra<std::int32_t> radix(g);
+    BidirectionalDijkstra<std::int32_t> bidir(g);
+    std::vector<int> path;
+    auto manhattan = [&](int u, int v) {
+        return static_cast<std::int64_t>(std::abs(u / n - v / n) + std::abs(u % n - v % n));
+    };
+    const auto expected = Reference(g, 5);
+    for (int t : {0, 5, n - 1, n * n / 2 + 3, n * n - 1}) {
+        auto h = [&](int v) {
+            return manhattan(v, t);
+        };
+        auto from_source = [&](int v) {
+            return manhattan(5, v);
+        };
+        assert(dijkstra.Run(5, t, h) == expected[t]);
+        assert(dijkstra.PathTo(t, path) && Length(g, path) == expected[t]);
+        assert(radix.Run(5, t, h) == expected[t]);
+        assert(bidir.Run(5, t, h, from_source) == expected[t]);
+        assert(bidir.Path(path) && path.front() == 5 && path.back() == t && Length(g, path) == expected[t]);
+    }
+}
+
+// zero weight cycles tie many parents, the parent links must still be a tree
+void TestZeroWeights(ThreadPool& pool) {
+    for (unsigned seed = 1; seed <= 3; seed++) {
+        auto edges = RandomEdges(300, 1500, 3, seed);
+        for (auto& e : edges) {
+            e.w -= 1;
+        }
+        for (bool directed : {false, true}) {
+            const WeightedCsrGraphI32 g(300, edges, directed);
+            DeltaStepping<std::int32_t> delta(g);
+            for (int s : {0, 150}) {
+                delta.Run(s, &pool);
+                CheckEngine(g, delta, s, Reference(g, s));
+                delta.Run(s, 1, nullptr);
+                CheckEngine(g, delta, s, Reference(g, s));
+            }
+        }
+    }
+}
+
+// bucket indices far apart: one huge weight, or a tiny delta
+void TestSkewedWeights(ThreadPool& pool) {
+    auto edges = RandomEdges(300, 1500, 2, 4);
+    edges.push_back(Edge(0, 299, 1000000000));
+    const WeightedCsrGraphI32 g(300, edges, true);
+    DeltaStepping<std::int32_t> delta(g);
+    delta.Run(0, &pool);
+    CheckEngine(g, delta, 0, Reference(g, 0));
+    assert(!delta.Run(0, 0, nullptr) && !delta.Run(0, -1, nullptr));
+
+    const WeightedCsrGraphF64 f(300, RandomEdges(300, 1500, 100, 5), true);
+    DeltaStepping<double> fine(f);
+    assert(fine.Run(0, 1e-300, &pool));
+    CheckEngine(f, fine, 0, Reference(f, 0));
+}
+} // namespace
+
+int main() {
+    ThreadPool pool(4);
+
+    const WeightedGraph w1 = WeightedGraph_1();
+    TestGraph(WeightedCsrGraphF64(w1), pool);
+    TestGraph(WeightedCsrGraphI32(w1), pool);
+    TestRadix(WeightedCsrGraphI32(w1));
+
+    for (unsigned seed = 1; seed <= 3; seed++) {
+        const auto edges = RandomEdges(300, 1500, 100, seed);
+        for (bool directed : {false, true}) {
+            TestGraph(WeightedCsrGraphI32(300, edges, directed), pool);
+            TestGraph(WeightedCsrGraphF32(300, edges, directed), pool);
+            TestGraph(WeightedCsrGraphF64(300, edges, directed), pool);
+            TestRadix(WeightedCsrGraphI32(300, edges, directed));
+        }
+    }
+    TestAStar();
+    TestZeroWeights(pool);
+    TestSkewedWeights(pool);
+
+    // large sparse graph, parallel delta-stepping against Dijkstra
+    const WeightedCsrGraphI32 big(200000, RandomEdges(200000, 1000000, 1000, 11), true);
+    Dijkstra<std::int32_t> reference(big);
+    DeltaStepping<std::int32_t> delta(big);
+    reference.Run(0);
+    delta.Run(0, &pool);
+    assert(delta.dist == reference.dist);
+
+    std::cout << "Success" << std::endl;
+    return 0;
+}
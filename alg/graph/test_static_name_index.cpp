@@ -0,0 +1,130 @@
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "static_name_index.h"
+
+using namespace alg;
+
+namespace {
+std::string TempPath(const std::string& name) {
+    const char* dir = std::getenv("TEST_TMPDIR");
+    return std::string(dir ? dir : "/tmp") + "/" + name;
+}
+
+// copy of a blob at a fresh 8-byte aligned address
+std::vector<std::uint64_t> Copy(const char* data, std::size_t size) {
+    std::vector<std::uint64_t> copy((size + 7) / 8);
+    std::memcpy(copy.data(), data, size);
+    return copy;
+}
+
+template <class Index>
+void CheckIndex(const Index& index, const std::vector<std::string>& names) {
+    assert(index.Count() == static_cast<int>(names.size()));
+    for (std::size_t i = 0; i < names.size(); i++) {
+        assert(index.IndexByName(names[i].c_str()) == static_cast<int>(i));
+    }
+    assert(index.IndexByName("zzz") == -1);
+}
+
+template <class Index>
+void CheckSmall() {
+    const std::vector<std::string> names = {"but", "that", "river", "see", "dog", "", "rivers"};
+    Index index;
+    assert(index.Count() == 0 && index.IndexByName("but") == -1);
+    assert(index.Build(names));
+    CheckIndex(index, names);
+    assert(index.IndexByName("riv") == -1 && index.IndexByName("butt") == -1);
+    assert(!index.Build({"a", "b", "a"}));
+
+    Index empty;
+    assert(empty.Build({}) && empty.Count() == 0);
+    assert(empty.IndexByName("") == -1 && empty.IndexByName("a") == -1);
+
+    // a view of a copied blob answers the same, a damaged one is refused
+    std::vector<std::uint64_t> blob = Copy(index.Data(), index.Size());
+    Index view;
+    assert(view.View(blob.data(), index.Size()));
+    CheckIndex(view, names);
+    assert(!view.View(blob.data(), index.Size() - 8));
+    reinterpret_cast<char*>(blob.data())[0] = 'X';
+    assert(!view.View(blob.data(), index.Size()));
+
+    Index moved = std::move(index);
+    CheckIndex(moved, names);
+}
+
+template <class Index>
+void CheckMapped(const std::vector<std::string>& names) {
+    Index built;
+    assert(built.Build(names));
+    CheckIndex(built, names);
+
+    const std::string path = TempPath("static_name_index.bin");
+    FILE* f = std::fopen(path.c_str(), "wb");
+    assert(f && std::fwrite(built.Data(), 1, built.Size(), f) == built.Size());
+    std::fclose(f);
+
+    const int fd = open(path.c_str(), O_RDONLY);
+    assert(fd != -1);
+    void* map = mmap(nullptr, built.Size(), PROT_READ, MAP_PRIVATE, fd, 0);
+    assert(map != MAP_FAILED);
+    Index mapped;
+    assert(mapped.View(map, built.Size()));
+    CheckIndex(mapped, names);
+    munmap(map, built.Size());
+    close(fd);
+    std::remove(path.c_str());
+}
+} // namespace
+
+int main() {
+    CheckSmall<PerfectNameHash>();
+    CheckSmall<DoubleArrayTrie>();
+
+    // random distinct names with shared prefixes
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> len(1, 12), letter('a', 'e');
+    std::set<std::string> unique;
+    std::vector<std::string> names;
+    while (names.size() < 20000) {
+        std::string s;
+        for (int k = len(gen); k > 0; k--) {
+            s += static_cast<char>(letter(gen));
+        }
+        if (unique.insert(s).second)
+            names.push_back(s);
+    }
+    names.push_back("\xff\x80 high bytes");
+    unique.insert(names.back());
+    CheckMapped<PerfectNameHash>(names);
+    CheckMapped<DoubleArrayTrie>(names);
+
+    // prefix queries come back in name order
+    DoubleArrayTrie trie;
+    assert(trie.Build(names));
+    for (const char* prefix : {"", "a", "abc", "eeee", "\xff"}) {
+        std::vector<int> ids;
+        trie.WithPrefix(prefix, ids);
+        std::vector<int> expected;
+        for (auto it = unique.lower_bound(prefix); it != unique.end() && it->compare(0, std::strlen(prefix), prefix) == 0; ++it) {
+            expected.push_back(trie.IndexByName(it->c_str()));
+        }
+        assert(ids == expected);
+    }
+    std::vector<int> ids = {1};
+    trie.WithPrefix("x", ids);
+    assert(ids.empty());
+    std::cout << "Success" << std::endl;
+}
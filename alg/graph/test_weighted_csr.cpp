@@ -0,0 +1,78 @@
+#include <cassert>
+#include <iostream>
+
+#include "weighted_csr.h"
+#include "instance.h"
+
+using namespace alg;
+
+namespace {
+template <typename W, typename DenseGraph>
+void AssertSameEdges(const DenseGraph& g, const WeightedCsrGraph<W>& csr) {
+    assert(g.V == csr.V);
+    for (int u = 0; u < g.V; u++) {
+        const auto dense = g.Edges(u);
+        const auto sparse = csr.Edges(u);
+        assert(dense.size() == sparse.size());
+        std::size_t i = 0;
+        for (const auto& a : sparse) {
+            assert(a.v == dense[i].v);
+            assert(a.w == static_cast<W>(dense[i].w));
+            i++;
+        }
+    }
+}
+} // namespace
+
+int main() {
+    // dense -> csr, all weight types
+    {
+        const auto& graph = WeightedGraph_1();
+        AssertSameEdges(graph, WeightedCsrGraphF64(graph));
+        AssertSameEdges(graph, WeightedCsrGraphF32(graph));
+        AssertSameEdges(graph, WeightedCsrGraphI32(graph));
+        assert(WeightedCsrGraphF64(graph).E == graph.E);
+    }
+
+    // edge list -> csr, a repeated edge keeps the last weight
+    {
+        std::vector<Edge> edges = {Edge(0, 1, 3), Edge(1, 2, 4), Edge(1, 0, 7)};
+        WeightedCsrGraphI32 csr(3, edges);
+        assert(csr.E == 2);
+        assert(csr.Weights(0)[0] == 7);
+        assert(csr.Targets(1)[0] == 0 && csr.Weights(1)[0] == 7);
+        assert(csr.Edges().size() == 2);
+    }
+
+    // directed
+    {
+        DirectedWeightedGraph graph(3);
+        graph.AddEdge(0, 1, 1.5);
+        graph.AddEdge(1, 2, 2.5);
+        graph.AddEdge(2, 0, 3.5);
+        WeightedCsrGraphF32 csr(graph);
+        AssertSameEdges(graph, csr);
+        assert(csr.E == 3);
+        assert(csr.Topology().Adj(2)[0] == 0);
+    }
+
+    // large sparse graph, average degree ~3
+    {
+        const int n = 2000000;
+        std::vector<Edge> edges;
+        for (int i = 0; i + 1 < n; i++) {
+            edges.push_back(Edge(i, i + 1, i % 7));
+            if (i % 2 == 0 && i + 2 < n)
+                edges.push_back(Edge(i, i + 2, 1));
+        }
+        WeightedCsrGraphI32 csr(n, edges);
+        assert(csr.E == static_cast<std::int64_t>(edges.size()));
+        std::int64_t sum = 0;
+        for (const auto& a : csr.Edges(10)) {
+            sum += a.w;
+        }
+        assert(sum == 10 % 7 + 9 % 7 + 1 + 1);
+    }
+
+    std::cout << "Success" << std::endl;
+}
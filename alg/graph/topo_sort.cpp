@@ -0,0 +1,94 @@
+#include <algorithm>
+
+#include "topo_sort.h"
+
+namespace alg {
+namespace {
+constexpr std::int64_t kGrain = 256;
+} // namespace
+
+bool TopoSort::Run(ThreadPool* pool) {
+    const int V = g.V;
+    const bool parallel = pool && pool->Size() > 1;
+    indeg.reset(new std::atomic<int>[V]);
+    for (int u = 0; u < V; u++) {
+        indeg[u].store(0, std::memory_order_relaxed);
+    }
+    if (parallel) {
+        locals.resize(pool->Size());
+        pool->ParallelFor(V, kGrain * 16, [&](std::int64_t b, std::int64_t e, int) {
+            for (std::int64_t u = b; u < e; u++) {
+                for (int w : g.Adj(u)) {
+                    indeg[w].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    else {
+        for (std::int64_t k = 0; k < g.offsets[V]; k++) {
+            const int w = g.neighbors[k];
+            indeg[w].store(indeg[w].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    order.resize(V);
+    level.assign(V, -1);
+    level_offsets.assign(1, 0);
+    int tail = 0;
+    for (int u = 0; u < V; u++) {
+        if (indeg[u].load(std::memory_order_relaxed) == 0) {
+            order[tail++] = u;
+            level[u] = 0;
+        }
+    }
+
+    int head = 0, k = 0;
+    while (head < tail) {
+        level_offsets.push_back(tail);
+        int next = parallel ? ExpandParallel(head, tail, k, *pool) : Expand(head, tail, k);
+        std::sort(order.begin() + tail, order.begin() + next);
+        head = tail;
+        tail = next;
+        k++;
+    }
+    order.resize(tail);
+    indeg.reset();
+    return tail == V;
+}
+
+int TopoSort::Expand(int head, int tail, int k) {
+    int next = tail;
+    for (int i = head; i < tail; i++) {
+        for (int w : g.Adj(order[i])) {
+            int d = indeg[w].load(std::memory_order_relaxed) - 1;
+            indeg[w].store(d, std::memory_order_relaxed);
+            if (d == 0) {
+                level[w] = k + 1;
+                order[next++] = w;
+            }
+        }
+    }
+    return next;
+}
+
+int TopoSort::ExpandParallel(int head, int tail, int k, ThreadPool& pool) {
+    std::atomic<int> next(tail);
+    pool.ParallelFor(tail - head, kGrain, [&](std::int64_t b, std::int64_t e, int tid) {
+        auto& local = locals[tid];
+        local.clear();
+        for (std::int64_t i = head + b; i < head + e; i++) {
+            for (int w : g.Adj(order[i])) {
+                // the last predecessor to finish releases w
+                if (indeg[w].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    level[w] = k + 1;
+                    local.push_back(w);
+                }
+            }
+        }
+        int at = next.fetch_add(local.size(), std::memory_order_relaxed);
+        std::copy(local.begin(), local.end(), order.begin() + at);
+    });
+    return next.load();
+}
+
+} // namespace alg
@@ -0,0 +1,59 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+#include "alg/common/thread_pool.h"
+#include "csr.h"
+
+namespace alg {
+
+/**
+ * @brief Kahn's topological sort, one level at a time
+ *
+ * Level k holds the vertices whose longest path from a source has k edges.
+ * All vertices of a level are independent, so with a pool each level is
+ * expanded in parallel by decrementing atomic in-degrees. Every level is
+ * sorted by vertex id, which makes the order the same with or without a
+ * pool. The graph must outlive the engine.
+ */
+class TopoSort {
+public:
+    explicit TopoSort(const GraphView& graph)
+        : g(graph) {}
+
+    /**
+     * @brief false if the graph has a cycle, order then holds the sortable part
+     */
+    bool Run(ThreadPool* pool = nullptr);
+
+    int Levels() const {
+        return static_cast<int>(level_offsets.size()) - 1;
+    }
+
+    /**
+     * @brief Vertices of level k
+     */
+    Span<int> Level(int k) const {
+        return Span<int>(order.data() + level_offsets[k], order.data() + level_offsets[k + 1]);
+    }
+
+public:
+    std::vector<int> order;
+    // level k is order[level_offsets[k], level_offsets[k + 1])
+    std::vector<int> level_offsets;
+    // level of every vertex, -1 on a cycle
+    std::vector<int> level;
+
+private:
+    int Expand(int head, int tail, int k);
+    int ExpandParallel(int head, int tail, int k, ThreadPool& pool);
+
+private:
+    GraphView g;
+    std::unique_ptr<std::atomic<int>[]> indeg;
+    std::vector<std::vector<int>> locals;
+};
+
+} // namespace alg
@@ -0,0 +1,9 @@
+#include "weighted_csr.h"
+
+namespace alg {
+
+template class WeightedCsrGraph<float>;
+template class WeightedCsrGraph<std::int32_t>;
+template class WeightedCsrGraph<double>;
+
+} // namespace alg
@@ -0,0 +1,334 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <algorithm>
+
+#include "edge.h"
+#include "graph.h"
+#include "csr.h"
+
+namespace alg {
+
+/**
+ * @brief Out-edge (u, v, w) of a fixed source u
+ */
+template <typename W>
+struct Arc {
+    int v;
+    W w;
+};
+
+/**
+ * @brief Zipped view over the target and weight columns of one row
+ */
+template <typename W>
+class ArcRange {
+public:
+    class Iterator {
+    public:
+        Iterator(const int* t, const W* w)
+            : target(t), weight(w) {}
+
+        Arc<W> operator*() const {
+            return Arc<W>{*target, *weight};
+        }
+        Iterator& operator++() {
+            ++target;
+            ++weight;
+            return *this;
+        }
+        bool operator!=(const Iterator& other) const {
+            return target != other.target;
+        }
+
+    private:
+        const int* target;
+        const W* weight;
+    };
+
+    ArcRange(const int* t, const W* w, std::size_t n)
+        : targets(t), weights(w), count(n) {}
+
+    Iterator begin() const {
+        return Iterator(targets, weights);
+    }
+    Iterator end() const {
+        return Iterator(targets + count, weights + count);
+    }
+    std::size_t size() const {
+        return count;
+    }
+    bool empty() const {
+        return count == 0;
+    }
+
+private:
+    const int* targets;
+    const W* weights;
+    std::size_t count;
+};
+
+/**
+ * @brief Immutable weighted CSR graph with struct-of-arrays columns
+ *
+ * Row u is targets/weights[offsets[u], offsets[u + 1]), sorted by target.
+ * A repeated (u, v) keeps the weight added last, like the dense AddEdge().
+ */
+template <typename W>
+class WeightedCsrGraph {
+public:
+    using Weight = W;
+
+    WeightedCsrGraph()
+        : V(0),
+          E(0),
+          directed(false),
+          offsets(1, 0) {
+    }
+
+    WeightedCsrGraph(int vertices, const std::vector<Edge>& edges, bool is_directed = false)
+        : V(vertices),
+          E(0),
+          directed(is_directed),
+          offsets(vertices + 1, 0) {
+        for (const auto& e : edges) {
+            offsets[e.u + 1]++;
+            if (!directed && e.u != e.v)
+                offsets[e.v + 1]++;
+        }
+        for (int u = 0; u < V; u++) {
+            offsets[u + 1] += offsets[u];
+        }
+
+        targets.resize(offsets[V]);
+        weights.resize(offsets[V]);
+        std::vector<std::int64_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (const auto& e : edges) {
+            std::int64_t k = cursor[e.u]++;
+            targets[k] = e.v;
+            weights[k] = static_cast<W>(e.w);
+            if (!directed && e.u != e.v) {
+                k = cursor[e.v]++;
+                targets[k] = e.u;
+                weights[k] = static_cast<W>(e.w);
+            }
+        }
+
+        SortAndCompact();
+    }
+
+    explicit WeightedCsrGraph(const WeightedGraph& g)
+        : V(g.V),
+          E(0),
+          directed(false) {
+        FromDense(g.adj);
+    }
+
+    explicit WeightedCsrGraph(const DirectedWeightedGraph& g)
+        : V(g.V),
+          E(0),
+          directed(true) {
+        FromDense(g.adj);
+    }
+
+    ArcRange<W> Edges(int u) const {
+        return ArcRange<W>(targets.data() + offsets[u], weights.data() + offsets[u], Deg(u));
+    }
+    Span<int> Targets(int u) const {
+        return Span<int>(targets.data() + offsets[u], targets.data() + offsets[u + 1]);
+    }
+    Span<W> Weights(int u) const {
+        return Span<W>(weights.data() + offsets[u], weights.data() + offsets[u + 1]);
+    }
+
+    int Deg(int u) const {
+        return static_cast<int>(offsets[u + 1] - offsets[u]);
+    }
+
+    /**
+     * @brief Weighted edge list, each undirected edge once with u <= v
+     */
+    std::vector<Edge> Edges() const {
+        std::vector<Edge> edges;
+        edges.reserve(E);
+        for (int u = 0; u < V; u++) {
+            for (const auto& a : Edges(u)) {
+                if (directed || u <= a.v)
+                    edges.push_back(Edge(u, a.v, a.w));
+            }
+        }
+        return edges;
+    }
+
+    /**
+     * @brief Graph with every edge reversed, a copy if undirected
+     */
+    WeightedCsrGraph Transpose() const {
+        if (!directed)
+            return *this;
+        std::vector<Edge> edges = Edges();
+        for (auto& e : edges) {
+            std::swap(e.u, e.v);
+        }
+        return WeightedCsrGraph(V, edges, true);
+    }
+
+    /**
+     * @brief Unweighted topology without copying
+     */
+    GraphView View() const {
+        return GraphView(V, E, directed, offsets.data(), targets.data());
+    }
+
+    /**
+     * @brief Unweighted topology
+     */
+    CsrGraph Topology() const {
+        CsrGraph g;
+        g.V = V;
+        g.E = E;
+        g.directed = directed;
+        g.offsets = offsets;
+        g.neighbors = targets;
+        return g;
+    }
+
+    void Show() const {
+        std::cout << "WeightedCsrGraph:" << V << std::endl;
+        for (int i = 0; i < V; i++) {
+            const auto edges = Edges(i);
+            if (!edges.empty()) {
+                for (const auto& a : edges) {
+                    std::cout << "(" << i << "," << a.v << "," << a.w << "),";
+                }
+                std::cout << std::endl;
+            }
+        }
+    }
+
+private:
+    void FromDense(const std::vector<std::vector<double>>& adj) {
+        offsets.assign(V + 1, 0);
+        for (int u = 0; u < V; u++) {
+            offsets[u + 1] = offsets[u] + std::count_if(adj[u].begin(), adj[u].end(), [](double d) {
+                return !IsInf(d);
+            });
+        }
+        targets.resize(offsets[V]);
+        weights.resize(offsets[V]);
+        for (int u = 0; u < V; u++) {
+            std::int64_t k = offsets[u];
+            for (int i = 0; i < V; i++) {
+                if (!IsInf( adj[u][i] )) {
+                    targets[k] = i;
+                    weights[k] = static_cast<W>(adj[u][i]);
+                    k++;
+                }
+            }
+        }
+        CountEdges();
+    }
+
+    // stable sort every row by target, keep the last weight of equal targets
+    void SortAndCompact() {
+        std::vector<std::pair<int, W>> row;
+        std::int64_t w = 0;
+        for (int u = 0; u < V; u++) {
+            row.clear();
+            for (std::int64_t k = offsets[u]; k < offsets[u + 1]; k++) {
+                row.emplace_back(targets[k], weights[k]);
+            }
+            std::stable_sort(row.begin(), row.end(), [](const auto& a, const auto& b) {
+                return a.first < b.first;
+            });
+            offsets[u] = w;
+            for (std::size_t i = 0; i < row.size(); i++) {
+                if (i + 1 < row.size() && row[i + 1].first == row[i].first)
+                    continue;
+                targets[w] = row[i].first;
+                weights[w] = row[i].second;
+                w++;
+            }
+        }
+        offsets[V] = w;
+        targets.resize(w);
+        targets.shrink_to_fit();
+        weights.resize(w);
+        weights.shrink_to_fit();
+        CountEdges();
+    }
+
+    void CountEdges() {
+        if (directed) {
+            E = targets.size();
+            return;
+        }
+        std::int64_t loops = 0;
+        for (int u = 0; u < V; u++) {
+            const auto t = Targets(u);
+            if (std::binary_search(t.begin(), t.end(), u))
+                loops++;
+        }
+        E = (static_cast<std::int64_t>(targets.size()) - loops) / 2 + loops;
+    }
+
+public:
+    int V;
+    std::int64_t E;
+    bool directed;
+    std::vector<std::int64_t> offsets;
+    std::vector<int> targets;
+    std::vector<W> weights;
+};
+
+/**
+ * @brief Non-owning weighted CSR, a GraphView plus the weight column
+ *
+ * What the weighted engines hold, so they run on a WeightedCsrGraph or a
+ * mapped file alike; a WeightedCsrGraph converts to it implicitly.
+ */
+template <typename W>
+class WeightedGraphView : public GraphView {
+public:
+    using Weight = W;
+
+    WeightedGraphView() = default;
+    WeightedGraphView(const WeightedCsrGraph<W>& g)
+        : GraphView(g.V, g.E, g.directed, g.offsets.data(), g.targets.data()),
+          weights(g.weights.data()) {}
+    WeightedGraphView(const GraphView& topology, const W* row_weights)
+        : GraphView(topology),
+          weights(row_weights) {}
+
+    ArcRange<W> Edges(int u) const {
+        return ArcRange<W>(neighbors + offsets[u], weights + offsets[u], Deg(u));
+    }
+    Span<W> Weights(int u) const {
+        return Span<W>(weights + offsets[u], weights + offsets[u + 1]);
+    }
+
+    /**
+     * @brief Weighted edge list, each undirected edge once with u <= v
+     */
+    std::vector<Edge> Edges() const {
+        std::vector<Edge> edges;
+        edges.reserve(E);
+        for (int u = 0; u < V; u++) {
+            for (const auto& a : Edges(u)) {
+                if (directed || u <= a.v)
+                    edges.push_back(Edge(u, a.v, a.w));
+            }
+        }
+        return edges;
+    }
+
+public:
+    const W* weights = nullptr;
+};
+
+using WeightedCsrGraphF32 = WeightedCsrGraph<float>;
+using WeightedCsrGraphI32 = WeightedCsrGraph<std::int32_t>;
+using WeightedCsrGraphF64 = WeightedCsrGraph<double>;
+
+} // namespace alg